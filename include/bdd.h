@@ -0,0 +1 @@
+../src/bdd/bdd.h
\ No newline at end of file
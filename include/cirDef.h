@@ -0,0 +1 @@
+../src/cir/cirDef.h
\ No newline at end of file
@@ -0,0 +1 @@
+../src/sat/sat.h
\ No newline at end of file
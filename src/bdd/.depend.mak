@@ -0,0 +1 @@
+bdd.o: bdd.cpp bdd.h
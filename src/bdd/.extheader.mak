@@ -0,0 +1,4 @@
+bdd.d: ../../include/bdd.h 
+../../include/bdd.h: bdd.h
+	@rm -f ../../include/bdd.h
+	@ln -fs ../src/bdd/bdd.h ../../include/bdd.h
@@ -0,0 +1,303 @@
+/****************************************************************************
+  FileName     [ bdd.cpp ]
+  PackageName  [ bdd ]
+  Synopsis     [ Define BDD manager and node functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2005-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <cassert>
+#include "bdd.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+#define BDD_FREE_VAR       (~uint32_t(0))
+#define BDD_INIT_BUCKETS   (1 << 12)
+#define BDD_GC_THRESHOLD   (1 << 16)
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static inline size_t
+hash3(uint32_t a, uint32_t b, uint32_t c)
+{
+   uint64_t h = uint64_t(a) * 0x9E3779B97F4A7C15ULL;
+   h ^= uint64_t(b) * 0xC2B2AE3D27D4EB4FULL;
+   h ^= uint64_t(c) * 0x165667B19E3779F9ULL;
+   return size_t(h ^ (h >> 29));
+}
+
+/**************************************/
+/*   class BddNode member functions   */
+/**************************************/
+BddNode::BddNode(BddMgr* mgr, BddEdge e): _mgr(mgr), _edge(e)
+{
+   if(_mgr) _mgr->ref(_edge);
+}
+
+BddNode::BddNode(const BddNode& n): _mgr(n._mgr), _edge(n._edge)
+{
+   if(_mgr) _mgr->ref(_edge);
+}
+
+BddNode::~BddNode()
+{
+   if(_mgr) _mgr->deref(_edge);
+}
+
+const BddNode&
+BddNode::operator = (const BddNode& n)
+{
+   if(n._mgr) n._mgr->ref(n._edge);
+   if(_mgr) _mgr->deref(_edge);
+   _mgr = n._mgr; _edge = n._edge;
+   return *this;
+}
+
+BddNode
+BddNode::operator ~ () const
+{
+   return BddNode(_mgr, isNull()? BDD_NULL: _edge ^ 1);
+}
+
+BddNode
+BddNode::operator & (const BddNode& n) const
+{
+   if(_mgr == 0) return BddNode();
+   return _mgr->ite(*this, n, _mgr->getConst(false));
+}
+
+BddNode
+BddNode::operator | (const BddNode& n) const
+{
+   if(_mgr == 0) return BddNode();
+   return _mgr->ite(*this, _mgr->getConst(true), n);
+}
+
+BddNode
+BddNode::operator ^ (const BddNode& n) const
+{
+   if(_mgr == 0) return BddNode();
+   return _mgr->ite(*this, ~n, n);
+}
+
+/*************************************/
+/*   class BddMgr member functions   */
+/*************************************/
+BddMgr::BddMgr(unsigned nVars, size_t maxNodes, unsigned cacheBits)
+   : _nVars(nVars), _maxNodes(maxNodes), _freeList(0), _nFree(0),
+     _gcThreshold(BDD_GC_THRESHOLD)
+{
+   Node one = { nVars, BDD_TRUE, BDD_TRUE, 0, 1 };
+   _nodes.push_back(one);
+   _buckets.assign(BDD_INIT_BUCKETS, 0);
+   CacheEntry empty = { BDD_NULL, BDD_NULL, BDD_NULL, BDD_NULL };
+   _cache.assign(size_t(1) << cacheBits, empty);
+}
+
+BddNode
+BddMgr::getVar(unsigned v)
+{
+   assert(v < _nVars);
+   BddEdge r = findOrAdd(v, BDD_TRUE, BDD_FALSE);
+   if(r == BDD_NULL) { collectGarbage(); r = findOrAdd(v, BDD_TRUE, BDD_FALSE); }
+   return BddNode(this, r);
+}
+
+// The intermediate results of an operation are not referenced, so nodes
+// are only collected before it starts, or when it runs out of nodes (and
+// is then restarted once)
+BddNode
+BddMgr::ite(const BddNode& f, const BddNode& g, const BddNode& h)
+{
+   if(f.isNull() || g.isNull() || h.isNull()) return BddNode();
+   maybeCollect();
+   BddEdge r = iteRec(f.getEdge(), g.getEdge(), h.getEdge());
+   if(r == BDD_NULL){
+      collectGarbage();
+      r = iteRec(f.getEdge(), g.getEdge(), h.getEdge());
+   }
+   return BddNode(this, r);
+}
+
+// Shannon expansion bottom-up: P(f) = p P(f_v) + (1 - p) P(f_!v)
+double
+BddMgr::getProbability(const BddNode& f, const vector<double>& p1) const
+{
+   assert(!f.isNull());
+   unordered_map<uint32_t, double> prob;
+   prob[0] = 1.0;
+   vector<uint32_t> stack(1, f.getEdge() >> 1);
+   while(!stack.empty()){
+      uint32_t i = stack.back();
+      if(prob.count(i)) { stack.pop_back(); continue; }
+      const Node& n = _nodes[i];
+      unordered_map<uint32_t, double>::const_iterator t = prob.find(n._then >> 1);
+      if(t == prob.end()) { stack.push_back(n._then >> 1); continue; }
+      unordered_map<uint32_t, double>::const_iterator e = prob.find(n._else >> 1);
+      if(e == prob.end()) { stack.push_back(n._else >> 1); continue; }
+      double pt = (n._then & 1)? 1 - t->second: t->second;
+      double pe = (n._else & 1)? 1 - e->second: e->second;
+      double p = p1.empty()? 0.5: p1[n._var];
+      prob[i] = p * pt + (1 - p) * pe;
+      stack.pop_back();
+   }
+   double p = prob[f.getEdge() >> 1];
+   return (f.getEdge() & 1)? 1 - p: p;
+}
+
+// Every edge other than FALSE leads to TRUE, so one walk down is enough
+bool
+BddMgr::getSatPattern(const BddNode& f, vector<int>& pattern) const
+{
+   assert(!f.isNull());
+   pattern.assign(_nVars, -1);
+   if(f.isFalse()) return false;
+   for(BddEdge e = f.getEdge(); (e >> 1) != 0; ){
+      BddEdge t = thenOf(e);
+      if(t != BDD_FALSE) { pattern[topVar(e)] = 1; e = t; }
+      else { pattern[topVar(e)] = 0; e = elseOf(e); }
+   }
+   return true;
+}
+
+// Mark from the referenced nodes, put the others on the free list, and
+// keep the cache entries whose nodes all survive
+void
+BddMgr::collectGarbage()
+{
+   vector<char> marked(_nodes.size(), 0);
+   vector<uint32_t> stack;
+   marked[0] = 1;
+   for(size_t i = 1, s = _nodes.size(); i < s; i++)
+      if(_nodes[i]._var != BDD_FREE_VAR && _nodes[i]._ref > 0)
+         stack.push_back(i);
+   while(!stack.empty()){
+      uint32_t i = stack.back(); stack.pop_back();
+      if(marked[i]) continue;
+      marked[i] = 1;
+      stack.push_back(_nodes[i]._then >> 1);
+      stack.push_back(_nodes[i]._else >> 1);
+   }
+   for(size_t i = 1, s = _nodes.size(); i < s; i++){
+      Node& n = _nodes[i];
+      if(n._var == BDD_FREE_VAR || marked[i]) continue;
+      n._var = BDD_FREE_VAR;
+      n._next = _freeList;
+      _freeList = i;
+      ++_nFree;
+   }
+   rehash(_buckets.size());
+   for(size_t i = 0, s = _cache.size(); i < s; i++){
+      CacheEntry& c = _cache[i];
+      if(c._f == BDD_NULL) continue;
+      if(!marked[c._f >> 1] || !marked[c._g >> 1] || !marked[c._h >> 1] ||
+         !marked[c._r >> 1])
+         c._f = c._g = c._h = c._r = BDD_NULL;
+   }
+}
+
+//------------------------------------------------------------------------
+//   Private member functions
+//------------------------------------------------------------------------
+// Normalized so that "f" and "g" are regular: ite(!f, g, h) = ite(f, h, g)
+// and ite(f, !g, h) = !ite(f, g, !h)
+BddEdge
+BddMgr::iteRec(BddEdge f, BddEdge g, BddEdge h)
+{
+   if(f == BDD_TRUE) return g;
+   if(f == BDD_FALSE) return h;
+   if(g == f) g = BDD_TRUE;
+   else if(g == (f ^ 1)) g = BDD_FALSE;
+   if(h == f) h = BDD_FALSE;
+   else if(h == (f ^ 1)) h = BDD_TRUE;
+   if(g == h) return g;
+   if(g == BDD_TRUE && h == BDD_FALSE) return f;
+   if(g == BDD_FALSE && h == BDD_TRUE) return f ^ 1;
+
+   if(f & 1) { f ^= 1; swap(g, h); }
+   BddEdge out = 0;
+   if(g & 1) { g ^= 1; h ^= 1; out = 1; }
+
+   CacheEntry& c = _cache[hash3(f, g, h) & (_cache.size() - 1)];
+   if(c._f == f && c._g == g && c._h == h) return c._r ^ out;
+
+   unsigned v = min(topVar(f), min(topVar(g), topVar(h)));
+   BddEdge f1 = f, f0 = f, g1 = g, g0 = g, h1 = h, h0 = h;
+   if(topVar(f) == v) { f1 = thenOf(f); f0 = elseOf(f); }
+   if(topVar(g) == v) { g1 = thenOf(g); g0 = elseOf(g); }
+   if(topVar(h) == v) { h1 = thenOf(h); h0 = elseOf(h); }
+   BddEdge t = iteRec(f1, g1, h1);
+   if(t == BDD_NULL) return BDD_NULL;
+   BddEdge e = iteRec(f0, g0, h0);
+   if(e == BDD_NULL) return BDD_NULL;
+   BddEdge r = findOrAdd(v, t, e);
+   if(r == BDD_NULL) return BDD_NULL;
+   c._f = f; c._g = g; c._h = h; c._r = r;
+   return r ^ out;
+}
+
+BddEdge
+BddMgr::findOrAdd(unsigned v, BddEdge t, BddEdge e)
+{
+   if(t == e) return t;
+   if(t & 1) {
+      BddEdge r = findOrAdd(v, t ^ 1, e ^ 1);
+      return (r == BDD_NULL)? r: r ^ 1;
+   }
+   size_t b = hashNode(v, t, e) & (_buckets.size() - 1);
+   for(uint32_t i = _buckets[b]; i != 0; i = _nodes[i]._next){
+      const Node& n = _nodes[i];
+      if(n._var == v && n._then == t && n._else == e) return i << 1;
+   }
+   uint32_t i;
+   if(_freeList != 0){
+      i = _freeList;
+      _freeList = _nodes[i]._next;
+      --_nFree;
+   }
+   else if(_nodes.size() < _maxNodes){
+      i = _nodes.size();
+      _nodes.push_back(Node());
+   }
+   else return BDD_NULL;
+   Node& n = _nodes[i];
+   n._var = v; n._then = t; n._else = e; n._ref = 0;
+   n._next = _buckets[b];
+   _buckets[b] = i;
+   if(getNumNodes() > 2 * _buckets.size()) rehash(2 * _buckets.size());
+   return i << 1;
+}
+
+size_t
+BddMgr::hashNode(unsigned v, BddEdge t, BddEdge e) const
+{
+   return hash3(v, t, e);
+}
+
+void
+BddMgr::rehash(size_t nBuckets)
+{
+   _buckets.assign(nBuckets, 0);
+   for(size_t i = 1, s = _nodes.size(); i < s; i++){
+      Node& n = _nodes[i];
+      if(n._var == BDD_FREE_VAR) continue;
+      size_t b = hashNode(n._var, n._then, n._else) & (nBuckets - 1);
+      n._next = _buckets[b];
+      _buckets[b] = i;
+   }
+}
+
+void
+BddMgr::maybeCollect()
+{
+   if(getNumNodes() < _gcThreshold) return;
+   collectGarbage();
+   _gcThreshold = max(_gcThreshold, 2 * getNumNodes());
+}
@@ -0,0 +1,134 @@
+/****************************************************************************
+  FileName     [ bdd.h ]
+  PackageName  [ bdd ]
+  Synopsis     [ Define a reduced ordered BDD package with complement edges ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2005-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef BDD_H
+#define BDD_H
+
+#include <vector>
+#include <iostream>
+#include <stdint.h>
+
+using namespace std;
+
+class BddMgr;
+
+//------------------------------------------------------------------------
+//   Edges
+//------------------------------------------------------------------------
+// An edge is (node index << 1) | complement. Node 0 is the constant 1, so
+// edge 0 is TRUE and edge 1 is FALSE. The then-edge of a node is never
+// complemented, which keeps every function canonical.
+typedef uint32_t  BddEdge;
+
+#define BDD_TRUE         BddEdge(0)
+#define BDD_FALSE        BddEdge(1)
+#define BDD_NULL         (~BddEdge(0))  // an operation ran out of nodes
+#define BDD_MAX_NODES    (1 << 22)
+#define BDD_CACHE_BITS   16
+
+//------------------------------------------------------------------------
+//   class BddNode
+//------------------------------------------------------------------------
+// A referenced handle to a function. The nodes reachable from a live
+// handle survive garbage collection. Operating on a null handle (or
+// running out of nodes) gives a null handle.
+class BddNode
+{
+public:
+  BddNode(): _mgr(0), _edge(BDD_NULL) {}
+  BddNode(BddMgr* mgr, BddEdge e);
+  BddNode(const BddNode& n);
+  ~BddNode();
+
+  const BddNode& operator = (const BddNode& n);
+  bool operator == (const BddNode& n) const { return _edge == n._edge; }
+  bool operator != (const BddNode& n) const { return _edge != n._edge; }
+  BddNode operator ~ () const;
+  BddNode operator & (const BddNode& n) const;
+  BddNode operator | (const BddNode& n) const;
+  BddNode operator ^ (const BddNode& n) const;
+
+  bool isNull() const { return _edge == BDD_NULL; }
+  bool isTrue() const { return _edge == BDD_TRUE; }
+  bool isFalse() const { return _edge == BDD_FALSE; }
+  BddEdge getEdge() const { return _edge; }
+
+private:
+  BddMgr*  _mgr;
+  BddEdge  _edge;
+};
+
+//------------------------------------------------------------------------
+//   class BddMgr
+//------------------------------------------------------------------------
+// Variable v is at level v (0 on top). Nodes are hash-consed in a unique
+// table and ITE results are memoized in a direct-mapped computed table.
+// Nodes are only collected between top-level operations, once the live
+// ones exceed a threshold that doubles with the survivors; an operation
+// that would need more than "maxNodes" nodes gives a null handle.
+class BddMgr
+{
+  friend class BddNode;
+
+public:
+  BddMgr(unsigned nVars, size_t maxNodes = BDD_MAX_NODES,
+         unsigned cacheBits = BDD_CACHE_BITS);
+  ~BddMgr() {}
+
+  unsigned getNumVars() const { return _nVars; }
+  BddNode getConst(bool v) { return BddNode(this, v? BDD_TRUE: BDD_FALSE); }
+  BddNode getVar(unsigned v);
+  BddNode ite(const BddNode& f, const BddNode& g, const BddNode& h);
+
+  // probability of f = 1 when variable v is 1 with probability p1[v]
+  // (0.5 for all of them if "p1" is empty)
+  double getProbability(const BddNode& f,
+                        const vector<double>& p1 = vector<double>()) const;
+  // a pattern with f = 1: 0/1 per variable, -1 if free; false if f = 0
+  bool getSatPattern(const BddNode& f, vector<int>& pattern) const;
+
+  void collectGarbage();
+  size_t getNumNodes() const { return _nodes.size() - _nFree; }
+
+private:
+  struct Node
+  {
+    uint32_t  _var;     // BDD_FREE_VAR if on the free list
+    BddEdge   _then;
+    BddEdge   _else;
+    uint32_t  _next;    // next node in the bucket or the free list
+    uint32_t  _ref;     // number of handles
+  };
+  struct CacheEntry
+  {
+    BddEdge   _f, _g, _h, _r;
+  };
+
+  unsigned            _nVars;
+  size_t              _maxNodes;
+  vector<Node>        _nodes;
+  vector<uint32_t>    _buckets;    // 0 ends a chain (node 0 is never hashed)
+  uint32_t            _freeList;   // 0 if empty
+  size_t              _nFree;
+  size_t              _gcThreshold;
+  vector<CacheEntry>  _cache;
+
+  unsigned topVar(BddEdge e) const { return _nodes[e >> 1]._var; }
+  BddEdge thenOf(BddEdge e) const { return _nodes[e >> 1]._then ^ (e & 1); }
+  BddEdge elseOf(BddEdge e) const { return _nodes[e >> 1]._else ^ (e & 1); }
+  void ref(BddEdge e) { if(e != BDD_NULL) ++_nodes[e >> 1]._ref; }
+  void deref(BddEdge e) { if(e != BDD_NULL) --_nodes[e >> 1]._ref; }
+
+  BddEdge iteRec(BddEdge f, BddEdge g, BddEdge h);
+  BddEdge findOrAdd(unsigned v, BddEdge t, BddEdge e);
+  size_t hashNode(unsigned v, BddEdge t, BddEdge e) const;
+  void rehash(size_t nBuckets);
+  void maybeCollect();
+};
+
+#endif // BDD_H
@@ -0,0 +1,2 @@
+cirBench.o: cirBench.cpp ../../include/cirMgr.h ../../include/cirDef.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
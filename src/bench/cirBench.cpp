@@ -0,0 +1,286 @@
+/****************************************************************************
+  FileName     [ cirBench.cpp ]
+  PackageName  [ bench ]
+  Synopsis     [ Define the benchmark driver of the cir engine ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "cirMgr.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+enum BenchStep
+{
+   BENCH_READ    = 0,
+   BENCH_DFS     = 1,
+   BENCH_NETLIST = 2,
+   BENCH_WRITE   = 3,
+   BENCH_SIM     = 4,
+   BENCH_SWEEP   = 5,
+   BENCH_OPT     = 6,
+   BENCH_STRASH  = 7,
+   BENCH_FRAIG   = 8,
+
+   BENCH_TOT_STEP
+};
+
+static const char* benchStepName[BENCH_TOT_STEP] = {
+   "read", "dfs", "netlist", "write", "sim", "sweep", "opt", "strash", "fraig"
+};
+
+// What a run sends back to the parent; a step that did not run takes -1
+struct BenchResult
+{
+   int     _status;   // 0: done, 1: read failed
+   int     _nPis;
+   int     _nPos;
+   int     _nAigs;
+   double  _seconds[BENCH_TOT_STEP];
+};
+
+//----------------------------------------------------------------------
+//    class CirBench
+//----------------------------------------------------------------------
+// One run of the selected steps on a fresh CirMgr, each step working on
+// the circuit as the steps before left it.
+class CirBench
+{
+public:
+  CirBench(const vector<bool>& steps): _steps(steps) {}
+
+  void run(const string& fileName, BenchResult& r) const;
+
+private:
+  const vector<bool>& _steps;
+};
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static void
+usage()
+{
+   cout << "Usage: cirBench [-Repeat <(int n)>] [-Steps <(string s,...)>] "
+        << "<(string aagFile)>..." << endl;
+}
+
+static string
+jsonString(const string& str)
+{
+   string s = "\"";
+   for(size_t i = 0, n = str.size(); i < n; i++){
+      unsigned char c = str[i];
+      if(c == '"' || c == '\\') { s += '\\'; s += c; }
+      else if(c == '\n') s += "\\n";
+      else if(c == '\t') s += "\\t";
+      else if(c == '\r') s += "\\r";
+      else if(c < 0x20){
+         char buf[8];
+         snprintf(buf, sizeof(buf), "\\u%04x", c);
+         s += buf;
+      }
+      else s += c;
+   }
+   return s + "\"";
+}
+
+static double
+elapsed(const chrono::steady_clock::time_point& start)
+{
+   return chrono::duration<double>(chrono::steady_clock::now() - start)
+          .count();
+}
+
+// Run once in a child process, so that its peak RSS is the run's own;
+// false if the child did not send back a whole result
+static bool
+forkRun(const CirBench& bench, const string& fileName, BenchResult& r,
+        long& peakKb, string& error)
+{
+   int fd[2];
+   if(pipe(fd) != 0) { error = "pipe failed"; return false; }
+   cout.flush(); cerr.flush();
+   pid_t pid = fork();
+   if(pid < 0){
+      close(fd[0]); close(fd[1]);
+      error = "fork failed";
+      return false;
+   }
+   if(pid == 0){
+      close(fd[0]);
+      ostringstream sink;   // the reports of the steps are not measured
+      cout.rdbuf(sink.rdbuf());
+      cerr.rdbuf(sink.rdbuf());
+      BenchResult res;
+      bench.run(fileName, res);
+      ssize_t n = write(fd[1], &res, sizeof(res));
+      _exit(n == ssize_t(sizeof(res))? 0: 1);
+   }
+   close(fd[1]);
+   size_t got = 0;
+   for(ssize_t n; got < sizeof(r) &&
+       (n = read(fd[0], (char*)&r + got, sizeof(r) - got)) > 0; )
+      got += n;
+   close(fd[0]);
+   int status = 0;
+   struct rusage ru;
+   if(wait4(pid, &status, 0, &ru) < 0) { error = "wait failed"; return false; }
+   peakKb = ru.ru_maxrss;
+#ifdef __APPLE__
+   peakKb /= 1024;   // bytes
+#endif
+   if(WIFSIGNALED(status)){
+      error = string("killed by signal ") + strsignal(WTERMSIG(status));
+      return false;
+   }
+   if(got != sizeof(r)) { error = "no result"; return false; }
+   return true;
+}
+
+static double
+median(vector<double> v)
+{
+   sort(v.begin(), v.end());
+   size_t n = v.size();
+   return (n % 2)? v[n / 2]: (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+/**************************************/
+/*   class CirBench member functions  */
+/**************************************/
+void
+CirBench::run(const string& fileName, BenchResult& r) const
+{
+   memset(&r, 0, sizeof(r));
+   for(unsigned s = 0; s < BENCH_TOT_STEP; s++) r._seconds[s] = -1;
+
+   CirMgr* mgr = new CirMgr;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   if(!mgr->readCircuit(fileName)) { r._status = 1; return; }
+   r._seconds[BENCH_READ] = elapsed(start);
+   r._nPis = mgr->getNumPIs();
+   r._nPos = mgr->getNumPOs();
+   r._nAigs = mgr->getNumAigs();
+
+   for(unsigned s = BENCH_DFS; s < BENCH_TOT_STEP; s++){
+      if(!_steps[s]) continue;
+      ostringstream null;
+      start = chrono::steady_clock::now();
+      switch(s){
+         case BENCH_DFS:     mgr->buildDfsList(); break;
+         case BENCH_NETLIST: mgr->printNetlist(); break;
+         case BENCH_WRITE:   mgr->writeAag(null); break;
+         case BENCH_SIM:     mgr->randomSim(); break;
+         case BENCH_SWEEP:   mgr->sweep(); break;
+         case BENCH_OPT:     mgr->optimize(); break;
+         case BENCH_STRASH:  mgr->strash(); break;
+         case BENCH_FRAIG:   mgr->fraig(); break;
+         default: assert(0); break;
+      }
+      r._seconds[s] = elapsed(start);
+   }
+   delete mgr;
+}
+
+//----------------------------------------------------------------------
+//    main()
+//----------------------------------------------------------------------
+// JSON to stdout: per file, the median and the minimum wall-clock seconds
+// of each step over the runs, and the largest peak RSS of a run. A file
+// that cannot be read is reported as such; a run that crashes fails the
+// benchmark (exit code 2).
+int
+main(int argc, char** argv)
+{
+   int repeat = 3;
+   vector<bool> steps(BENCH_TOT_STEP, true);
+   vector<string> files;
+   for(int i = 1; i < argc; i++){
+      if(myStrNCmp("-Repeat", argv[i], 2) == 0){
+         if(++i == argc || !myStr2Int(argv[i], repeat) || repeat <= 0){
+            cerr << "Error: illegal repeat count!!" << endl;
+            usage(); return 1;
+         }
+      }
+      else if(myStrNCmp("-Steps", argv[i], 2) == 0){
+         if(++i == argc) { usage(); return 1; }
+         steps.assign(BENCH_TOT_STEP, false);
+         steps[BENCH_READ] = true;   // always, as the others need a circuit
+         string list = argv[i], tok;
+         for(size_t pos = myStrGetTok(list, tok, 0, ','); tok.size();
+             pos = myStrGetTok(list, tok, pos, ',')){
+            unsigned s = 0;
+            while(s < BENCH_TOT_STEP && tok != benchStepName[s]) ++s;
+            if(s == BENCH_TOT_STEP){
+               cerr << "Error: unknown step \"" << tok << "\"!!" << endl;
+               usage(); return 1;
+            }
+            steps[s] = true;
+         }
+      }
+      else files.push_back(argv[i]);
+   }
+   if(files.empty()) { usage(); return 1; }
+
+   CirBench bench(steps);
+   ostringstream oss;
+   oss << setprecision(6);
+   oss << "{\n  \"repeat\": " << repeat << ",\n  \"steps\": [";
+   for(unsigned s = 0, n = 0; s < BENCH_TOT_STEP; s++)
+      if(steps[s]) oss << (n++? ", ": "") << jsonString(benchStepName[s]);
+   oss << "],\n  \"files\": [";
+   int nFailed = 0;
+   for(size_t f = 0, nf = files.size(); f < nf; f++){
+      cerr << "[" << f + 1 << "/" << nf << "] " << files[f] << endl;
+      vector<vector<double> > seconds(BENCH_TOT_STEP);
+      BenchResult r;
+      long peakKb = 0;
+      string error;
+      for(int k = 0; k < repeat && error.empty(); k++){
+         long kb = 0;
+         if(!forkRun(bench, files[f], r, kb, error)) { ++nFailed; break; }
+         if(r._status != 0) { error = "cannot read the circuit"; break; }
+         peakKb = max(peakKb, kb);
+         for(unsigned s = 0; s < BENCH_TOT_STEP; s++)
+            if(r._seconds[s] >= 0) seconds[s].push_back(r._seconds[s]);
+      }
+      oss << (f? ",": "") << "\n    {\n      \"file\": " << jsonString(files[f]);
+      if(!error.empty()){
+         oss << ",\n      \"error\": " << jsonString(error) << "\n    }";
+         continue;
+      }
+      oss << ",\n      \"pis\": " << r._nPis << ", \"pos\": " << r._nPos
+          << ", \"aigs\": " << r._nAigs
+          << ",\n      \"peak_rss_kb\": " << peakKb
+          << ",\n      \"seconds\": {";
+      for(unsigned s = 0, n = 0; s < BENCH_TOT_STEP; s++){
+         if(seconds[s].empty()) continue;
+         oss << (n++? ",": "") << "\n        " << jsonString(benchStepName[s])
+             << ": { \"median\": " << median(seconds[s]) << ", \"min\": "
+             << *min_element(seconds[s].begin(), seconds[s].end()) << " }";
+      }
+      oss << "\n      }\n    }";
+   }
+   oss << "\n  ]\n}";
+   cout << oss.str() << endl;
+   return nFailed? 2: 0;
+}
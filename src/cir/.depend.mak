@@ -1,7 +1,44 @@
+cirActivity.o: cirActivity.cpp cirMgr.h cirDef.h cirGate.h \
+ ../../include/bdd.h ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h
+cirBalance.o: cirBalance.cpp cirMgr.h cirDef.h cirGate.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirBdd.o: cirBdd.cpp cirMgr.h cirDef.h cirGate.h ../../include/bdd.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
+cirCec.o: cirCec.cpp cirMgr.h cirDef.h cirGate.h cirProver.h \
+ ../../include/sat.h ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h
+cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h cirGate.h cirCmd.h \
+ ../../include/cmdParser.h ../../include/cmdCharDef.h cirEqCache.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myProfile.h ../../include/cmdParser.h \
+ ../../include/myTrace.h
+cirCut.o: cirCut.cpp cirCut.h cirDef.h cirGate.h cirMgr.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
+cirDepth.o: cirDepth.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirDom.o: cirDom.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirEqCache.o: cirEqCache.cpp cirEqCache.h
+cirFraig.o: cirFraig.cpp cirMgr.h cirDef.h cirGate.h cirStrash.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ cirProver.h ../../include/sat.h cirEqCache.h ../../include/bdd.h \
+ ../../include/myTrace.h
 cirGate.o: cirGate.cpp cirGate.h cirDef.h cirMgr.h ../../include/util.h \
  ../../include/rnGen.h ../../include/myUsage.h
-cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
+cirMgr.o: cirMgr.cpp cirMgr.h cirDef.h cirGate.h cirStrash.h \
+ ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h \
+ ../../include/myTrace.h
+cirNpn.o: cirNpn.cpp cirNpn.h
+cirOpt.o: cirOpt.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
  ../../include/rnGen.h ../../include/myUsage.h
-cirCmd.o: cirCmd.cpp cirMgr.h cirDef.h cirGate.h cirCmd.h \
- ../../include/cmdParser.h ../../include/cmdCharDef.h \
+cirResub.o: cirResub.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h
+cirRewrite.o: cirRewrite.cpp cirMgr.h cirDef.h cirGate.h cirCut.h \
+ cirNpn.h cirStrash.h ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h
+cirSim.o: cirSim.cpp cirMgr.h cirDef.h cirGate.h ../../include/util.h \
+ ../../include/rnGen.h ../../include/myUsage.h ../../include/myTrace.h
+cirSupport.o: cirSupport.cpp cirMgr.h cirDef.h cirGate.h \
  ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
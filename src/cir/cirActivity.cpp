@@ -0,0 +1,155 @@
+/****************************************************************************
+  FileName     [ cirActivity.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define switching activity and signal probability estimation ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "bdd.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// symbolic names may contain commas or quotes
+static string
+csvQuote(const string& str)
+{
+   string s = "\"";
+   for(size_t i = 0, n = str.size(); i < n; i++){
+      if(str[i] == '"') s += '"';
+      s += str[i];
+   }
+   return s + "\"";
+}
+
+struct ToggleGreater
+{
+   ToggleGreater(const vector<size_t>& t): _toggles(t) {}
+   bool operator() (const CirGate* a, const CirGate* b) const {
+      return _toggles[a->getGateID()] > _toggles[b->getGateID()];
+   }
+   const vector<size_t>& _toggles;
+};
+
+/**********************************************/
+/*   Public member functions about activity   */
+/**********************************************/
+// The patterns form one sequence in time: the toggle rate of a gate is the
+// fraction of consecutive pattern pairs on which its value changes, and
+// its probability the fraction of patterns on which it is 1. Both are
+// popcounts over the 64-pattern simulation words; a word is shifted by one
+// pattern (carrying the last bit of the word before) to find the changes.
+// Under random inputs, a gate whose support has at most
+// CIR_ACTIVITY_BDD_SUPPORT PIs gets its exact probability from its BDD
+// instead.
+void
+CirMgr::printActivity(unsigned numGates, size_t nPatterns,
+                      istream* patternFile, ostream* csv) const
+{
+   vector<uint64_t> blocks;
+   if(patternFile){
+      if(!readPatterns(*patternFile, blocks, nPatterns)) return;
+      if(nPatterns == 0){
+         cerr << "Error: no pattern in the pattern file!!" << endl;
+         return;
+      }
+   }
+   GateList gates(_piList);
+   for(size_t i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) gates.push_back(_dfsList[i]);
+
+   size_t nPis = _piList.size();
+   vector<uint64_t> value(_totalList.size(), 0), words(nPis);
+   vector<uint64_t> lastBit(_totalList.size(), 0);
+   vector<size_t> ones(_totalList.size(), 0), toggles(_totalList.size(), 0);
+   RandomWordGen wordGen;
+   for(size_t p = 0; p < nPatterns; p += 64){
+      unsigned n = min(size_t(64), nPatterns - p);
+      uint64_t mask = (n == 64)? ~uint64_t(0): (uint64_t(1) << n) - 1;
+      if(patternFile)
+         copy(blocks.begin() + (p / 64) * nPis,
+              blocks.begin() + (p / 64 + 1) * nPis, words.begin());
+      else
+         for(size_t i = 0; i < nPis; i++) words[i] = wordGen();
+      simulate(words.empty()? 0: &words[0], value);
+      for(size_t i = 0, s = gates.size(); i < s; i++){
+         unsigned id = gates[i]->getGateID();
+         uint64_t v = value[id] & mask;
+         uint64_t change = (v ^ ((v << 1) | lastBit[id])) & mask;
+         if(p == 0) change &= ~uint64_t(1);   // nothing before the first
+         ones[id] += __builtin_popcountll(v);
+         toggles[id] += __builtin_popcountll(change);
+         lastBit[id] = v >> (n - 1);
+      }
+   }
+
+   vector<double> prob(_totalList.size(), -1);
+   size_t nExact = 0;
+   for(size_t i = 0, s = gates.size(); i < s; i++)
+      prob[gates[i]->getGateID()] =
+         double(ones[gates[i]->getGateID()]) / nPatterns;
+   if(!patternFile){
+      BddMgr bddMgr(nPis);
+      vector<BddNode> bdds;
+      buildBdds(bddMgr, bdds, CIR_ACTIVITY_BDD_SUPPORT);
+      for(size_t i = 0, s = gates.size(); i < s; i++){
+         const BddNode& f = bdds[gates[i]->getGateID()];
+         if(f.isNull()) continue;
+         prob[gates[i]->getGateID()] = bddMgr.getProbability(f);
+         ++nExact;
+      }
+   }
+
+   stable_sort(gates.begin(), gates.end(), ToggleGreater(toggles));
+   double nPairs = (nPatterns > 1)? nPatterns - 1: 1;
+   if(csv){
+      *csv << "type,id,name,probability,toggle_rate\n" << setprecision(6);
+      for(size_t i = 0, s = gates.size(); i < s; i++){
+         const CirGate* g = gates[i];
+         unsigned id = g->getGateID();
+         *csv << g->getTypeStr() << "," << id << ","
+              << csvQuote(g->getSymbols()) << "," << prob[id] << ","
+              << toggles[id] / nPairs << "\n";
+      }
+      csv->flush();
+   }
+
+   ostringstream oss;
+   oss << fixed << setprecision(4);
+   for(size_t i = 0, s = min(gates.size(), size_t(numGates)); i < s; i++){
+      const CirGate* g = gates[i];
+      unsigned id = g->getGateID();
+      oss << g->getTypeStr() << " " << id;
+      if(!g->getSymbols().empty()) oss << " (" << g->getSymbols() << ")";
+      oss << ": toggle rate " << toggles[id] / nPairs << ", probability "
+          << prob[id] << '\n';
+   }
+   double sumToggle = 0, sumProb = 0;
+   size_t nAigs = gates.size() - nPis;
+   for(size_t i = 0, s = gates.size(); i < s; i++){
+      if(!gates[i]->isAig()) continue;
+      sumToggle += toggles[gates[i]->getGateID()] / nPairs;
+      sumProb += prob[gates[i]->getGateID()];
+   }
+   oss << "Activity: " << nAigs << " AIG(s) over " << nPatterns
+       << " pattern(s) (" << (patternFile? "pattern file": "random inputs")
+       << "), toggle rate " << (nAigs? sumToggle / nAigs: 0.0)
+       << " and probability " << (nAigs? sumProb / nAigs: 0.0)
+       << " on average";
+   if(nExact > 0)
+      oss << "\nActivity: exact probability of " << nExact
+          << " gate(s) with at most " << CIR_ACTIVITY_BDD_SUPPORT
+          << " PI(s) in support";
+   cout << oss.str() << endl;
+}
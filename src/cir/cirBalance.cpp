@@ -0,0 +1,183 @@
+/****************************************************************************
+  FileName     [ cirBalance.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define AIG depth balancing ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include <ctime>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// level of every gate in "dfsList"; returns the maximum level over the POs
+static unsigned
+computeLevels(const GateList& dfsList, vector<unsigned>& level)
+{
+   unsigned depth = 0;
+   for(int i = 0, s = dfsList.size(); i < s; i++){
+      const CirGate* g = dfsList[i];
+      const vector<Pin>& fanin = g->getFanin();
+      unsigned l = 0;
+      for(int j = 0, n = fanin.size(); j < n; j++)
+         l = max(l, level[fanin[j].getPin()->getGateID()]);
+      if(g->getType() == PO_GATE) depth = max(depth, l);
+      else level[g->getGateID()] = g->isAig()? l + 1: 0;
+   }
+   return depth;
+}
+
+// A supergate stops at gates that are shared, complemented, or not AIGs;
+// such an AIG is the root of a supergate of its own.
+static bool
+isSuperRoot(const CirGate* g)
+{
+   const vector<Pin>& fanout = g->getFanout();
+   if(fanout.size() != 1 || !fanout[0].getPin()->isAig()) return true;
+   const vector<Pin>& fanin = fanout[0].getPin()->getFanin();
+   for(int j = 0, s = fanin.size(); j < s; j++)
+      if(fanin[j].getPin() == g) return fanin[j].getInvPhase();
+   return true;
+}
+
+static void
+collectSuper(CirGate* root, vector<Pin>& leaves, GateList& nodes)
+{
+   vector<Pin> stack(root->getFanin());
+   leaves.clear(); nodes.assign(1, root);
+   while(!stack.empty()){
+      Pin p = stack.back(); stack.pop_back();
+      CirGate* g = p.getPin();
+      if(!p.getInvPhase() && g->isAig() && g->getFanout().size() == 1){
+         nodes.push_back(g);
+         stack.insert(stack.end(), g->getFanin().begin(), g->getFanin().end());
+      }
+      else leaves.push_back(p);
+   }
+}
+
+struct LevelGreater
+{
+   LevelGreater(const vector<unsigned>& l): _level(l) {}
+   bool operator() (const Pin& a, const Pin& b) const {
+      return _level[a.getPin()->getGateID()] > _level[b.getPin()->getGateID()];
+   }
+   const vector<unsigned>& _level;
+};
+
+static bool
+litLess(const Pin& a, const Pin& b)
+{
+   return a.getLit() < b.getLit();
+}
+
+// Drop duplicated and constant-1 leaves. Return false if the conjunction
+// is constant 0 (a constant-0 leaf, or a leaf in both phases).
+static bool
+reduceLeaves(vector<Pin>& leaves, const CirGate* const0)
+{
+   sort(leaves.begin(), leaves.end(), litLess);
+   size_t n = 0;
+   for(size_t i = 0, s = leaves.size(); i < s; i++){
+      const Pin& p = leaves[i];
+      if(p.getPin() == const0){
+         if(!p.getInvPhase()) return false;
+         continue;
+      }
+      if(n > 0 && leaves[n-1].getPin() == p.getPin()){
+         if(leaves[n-1].getInvPhase() != p.getInvPhase()) return false;
+         continue;
+      }
+      leaves[n++] = p;
+   }
+   leaves.resize(n);
+   return true;
+}
+
+/**************************************************/
+/*   Public member functions about optimization   */
+/**************************************************/
+// Rebuild every AND supergate as a tree that always combines the two
+// earliest-arriving inputs. The old tree has at least as many nodes as the
+// new one needs, so its gates (and IDs) are reused; the root stays the root.
+// Since _dfsList is topological, the leaves of a supergate already carry
+// their final level when its root is visited.
+void
+CirMgr::balance()
+{
+   vector<unsigned> level(_totalList.size(), 0);
+   unsigned depthBefore = computeLevels(_dfsList, level);
+   unsigned aigBefore = 0;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++aigBefore;
+   clock_t start = clock();
+
+   CirGate* const0 = _totalList[0];
+   vector<Pin> leaves;
+   GateList nodes;
+   for(int i = 0, s = _dfsList.size(); i < s; i++){
+      CirGate* root = _dfsList[i];
+      if(!root->isAig() || !isSuperRoot(root)) continue;
+      collectSuper(root, leaves, nodes);
+      for(int j = 0, n = nodes.size(); j < n; j++){
+         const vector<Pin>& fanin = nodes[j]->getFanin();
+         for(int k = 0, m = fanin.size(); k < m; k++)
+            fanin[k].getPin()->removeFanout(nodes[j]);
+         if(j == 0) nodes[j]->clearFanin();
+         else nodes[j]->clearFanIO();
+      }
+      bool nonZero = reduceLeaves(leaves, const0);
+      size_t nUsed = (nonZero && leaves.size() > 1)? leaves.size() - 1: 0;
+      for(size_t j = nUsed; j < nodes.size(); j++){
+         if(j == 0) continue;
+         _totalList[nodes[j]->getGateID()] = 0;
+         _removedList.push_back(nodes[j]);
+      }
+      if(nUsed == 0){
+         if(!nonZero) mergeGate(root, const0, false);
+         else if(leaves.empty()) mergeGate(root, const0, true);
+         else mergeGate(root, leaves[0].getPin(), leaves[0].getInvPhase());
+         continue;
+      }
+      // "leaves" is kept sorted by decreasing level; pair the last two
+      stable_sort(leaves.begin(), leaves.end(), LevelGreater(level));
+      for(size_t j = nUsed; j > 0; j--){
+         Pin b = leaves.back(); leaves.pop_back();
+         Pin a = leaves.back(); leaves.pop_back();
+         CirGate* g = nodes[j - 1];
+         g->setFanin(a.getPin(), a.getInvPhase());
+         g->setFanin(b.getPin(), b.getInvPhase());
+         a.getPin()->setFanout(g);
+         b.getPin()->setFanout(g);
+         unsigned l = max(level[a.getPin()->getGateID()],
+                          level[b.getPin()->getGateID()]) + 1;
+         level[g->getGateID()] = l;
+         vector<Pin>::iterator it = leaves.end();
+         while(it != leaves.begin() && level[(it-1)->getPin()->getGateID()] < l)
+            --it;
+         leaves.insert(it, Pin(g, false));
+      }
+   }
+   buildDfsList();
+   strash(false);
+   clearFecGrps();   // reused gates compute new functions
+
+   double t = double(clock() - start) / CLOCKS_PER_SEC;
+   unsigned depthAfter = computeLevels(_dfsList, level);
+   unsigned aigAfter = 0;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++aigAfter;
+   cout << "Balancing: depth " << depthBefore << " -> " << depthAfter
+        << ", AIG " << aigBefore << " -> " << aigAfter << ", "
+        << setprecision(4) << t << " seconds" << endl;
+}
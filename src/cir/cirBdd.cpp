@@ -0,0 +1,66 @@
+/****************************************************************************
+  FileName     [ cirBdd.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define BDD construction of the circuit ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2005-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "bdd.h"
+#include "util.h"
+#include "myTrace.h"
+
+using namespace std;
+
+/*****************************************/
+/*   Public member functions about BDD   */
+/*****************************************/
+// "bdds" is indexed by gate ID; PI i is variable i of "mgr". The support
+// (sorted PI indices) of every AIG is merged from its fanins, and a gate
+// whose support has more than "maxSupport" PIs, or whose BDD runs out of
+// nodes, gets a null node (as do the gates above it). UNDEF gates are 0,
+// as in simulation.
+void
+CirMgr::buildBdds(BddMgr& mgr, vector<BddNode>& bdds, unsigned maxSupport)
+   const
+{
+   TRACE_SPAN("buildBdds");
+   assert(mgr.getNumVars() == _piList.size());
+   bdds.assign(_totalList.size(), BddNode());
+   BddNode zero = mgr.getConst(false);
+   for(size_t i = 0, s = _totalList.size(); i < s; i++){
+      const CirGate* g = _totalList[i];
+      if(g != 0 && (g->getType() == UNDEF_GATE || g->getType() == CONST_GATE))
+         bdds[i] = zero;
+   }
+   vector<IdList> support(_totalList.size());
+   if(maxSupport > 0)
+      for(size_t i = 0, s = _piList.size(); i < s; i++){
+         unsigned id = _piList[i]->getGateID();
+         bdds[id] = mgr.getVar(i);
+         support[id].assign(1, i);
+      }
+   IdList merged;
+   for(size_t i = 0, s = _dfsList.size(); i < s; i++){
+      const CirGate* g = _dfsList[i];
+      if(!g->isAig()) continue;
+      const Pin& a = g->getFanin()[0];
+      const Pin& b = g->getFanin()[1];
+      unsigned ia = a.getPin()->getGateID(), ib = b.getPin()->getGateID();
+      if(bdds[ia].isNull() || bdds[ib].isNull()) continue;
+      merged.clear();
+      set_union(support[ia].begin(), support[ia].end(),
+                support[ib].begin(), support[ib].end(),
+                back_inserter(merged));
+      if(merged.size() > maxSupport) continue;
+      bdds[g->getGateID()] = (a.getInvPhase()? ~bdds[ia]: bdds[ia]) &
+                             (b.getInvPhase()? ~bdds[ib]: bdds[ib]);
+      support[g->getGateID()] = merged;
+   }
+}
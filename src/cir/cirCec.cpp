@@ -0,0 +1,202 @@
+/****************************************************************************
+  FileName     [ cirCec.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define combinational equivalence checking ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <chrono>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirProver.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+#define CEC_SIM_MAX_FAILS   8
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// match[i] is the index in "b" of the port matched with a[i]
+static bool
+matchPorts(const GateList& a, const GateList& b, const string& type,
+           bool byName, vector<size_t>& match)
+{
+   if(a.size() != b.size()){
+      cerr << "Error: the numbers of " << type << "s do not match ("
+           << a.size() << " vs. " << b.size() << ")!!" << endl;
+      return false;
+   }
+   match.resize(a.size());
+   if(!byName){
+      for(size_t i = 0, s = a.size(); i < s; i++) match[i] = i;
+      return true;
+   }
+   map<string, size_t> index;
+   for(size_t j = 0, s = b.size(); j < s; j++){
+      const string& name = b[j]->getSymbols();
+      if(name.empty()){
+         cerr << "Error: " << type << "(" << j << ") of the second circuit "
+              << "has no symbolic name!!" << endl;
+         return false;
+      }
+      if(!index.insert(make_pair(name, j)).second){
+         cerr << "Error: symbolic name \"" << name << "\" is used by more "
+              << "than one " << type << "!!" << endl;
+         return false;
+      }
+   }
+   for(size_t i = 0, s = a.size(); i < s; i++){
+      map<string, size_t>::const_iterator it = index.find(a[i]->getSymbols());
+      if(it == index.end()){
+         cerr << "Error: " << type << "(" << i << ")";
+         if(!a[i]->getSymbols().empty())
+            cerr << " \"" << a[i]->getSymbols() << "\"";
+         cerr << " is not found in the second circuit!!" << endl;
+         return false;
+      }
+      match[i] = it->second;
+   }
+   return true;
+}
+
+static void
+reportCex(const GateList& piList, const GateList& poList, size_t po,
+          const vector<int>& cex)
+{
+   cout << "Non-equivalent: PO(" << po << ")";
+   if(!poList[po]->getSymbols().empty())
+      cout << " \"" << poList[po]->getSymbols() << "\"";
+   cout << " differs" << endl << "Counterexample: ";
+   for(size_t i = 0, s = piList.size(); i < s; i++)
+      cout << ((cex[i] > 0)? '1': '0');
+   cout << endl;
+}
+
+/******************************************************/
+/*   Public member functions about equivalence check   */
+/******************************************************/
+// Build the miter of this circuit and "other", whose PIs and POs are paired
+// by order or by symbolic name. Random simulation looks for a distinguishing
+// pattern first; then the miter is fraiged, after which a PO pair is
+// equivalent iff its XOR has become CONST0. Otherwise SAT gives the
+// counterexample, printed as a pattern over the PIs of this circuit.
+void
+CirMgr::cec(const CirMgr& other, bool byName, unsigned nThreads) const
+{
+   vector<size_t> piMatch, poMatch;
+   if(!matchPorts(_piList, other._piList, "PI", byName, piMatch) ||
+      !matchPorts(_poList, other._poList, "PO", byName, poMatch))
+      return;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   CirMgr miter;
+   miter.buildMiter(*this, other, piMatch, poMatch);
+   const GateList& miterPos = miter._poList;
+
+   vector<int> cex(_piList.size());
+   vector<uint64_t> words(_piList.size());
+   for(unsigned fails = 0; fails < CEC_SIM_MAX_FAILS; ){
+      for(size_t i = 0, s = words.size(); i < s; i++) words[i] = simRandom();
+      miter.simulate(words);
+      for(size_t i = 0, s = miterPos.size(); i < s; i++){
+         const Pin& p = miterPos[i]->getFanin()[0];
+         uint64_t v = miter._simValue[p.getPin()->getGateID()];
+         if(p.getInvPhase()) v = ~v;
+         if(v == 0) continue;
+         unsigned k = 0;
+         while(!((v >> k) & 1)) ++k;
+         for(size_t j = 0, t = words.size(); j < t; j++)
+            cex[j] = (words[j] >> k) & 1;
+         reportCex(_piList, _poList, i, cex);
+         return;
+      }
+      if(miter.refineFecGrps(~uint64_t(0))) fails = 0;
+      else ++fails;
+   }
+
+   miter.fraig(nThreads, false);
+   CirProver prover(miter._totalList);
+   for(size_t i = 0, s = miterPos.size(); i < s; i++){
+      const Pin& p = miterPos[i]->getFanin()[0];
+      if(p.getPin()->getType() == CONST_GATE && !p.getInvPhase()) continue;
+      if(prover.prove(0, p.getLit()) == 1) continue;
+      for(size_t j = 0, t = _piList.size(); j < t; j++)
+         cex[j] = prover.getPiValue(miter._piList[j]);
+      reportCex(_piList, _poList, i, cex);
+      return;
+   }
+   double t = chrono::duration<double>(chrono::steady_clock::now() - start)
+                 .count();
+   cout << "Equivalent: " << _poList.size() << " PO pair(s) proved in "
+        << setprecision(4) << t << " seconds" << endl;
+   cout << setprecision(6);
+}
+
+/*******************************************************/
+/*   Private member functions about equivalence check   */
+/*******************************************************/
+// Called on an empty manager. PI i is PI i of "a" and PI piMatch[i] of "b";
+// PO i is the XOR of PO i of "a" and PO poMatch[i] of "b". Only the AIGs
+// reachable from the POs are copied; UNDEF gates become CONST0.
+void
+CirMgr::buildMiter(const CirMgr& a, const CirMgr& b,
+                   const vector<size_t>& piMatch, const vector<size_t>& poMatch)
+{
+   _totalList.assign(1, new Const0());
+   Pin zero(_totalList[0], false);
+   vector<Pin> mapA(a._totalList.size(), zero);
+   vector<Pin> mapB(b._totalList.size(), zero);
+   for(size_t i = 0, s = a._piList.size(); i < s; i++){
+      CirGate* pi = new CirPiGate(_totalList.size() * 2);
+      pi->setSymbols(a._piList[i]->getSymbols());
+      _totalList.push_back(pi);
+      _piList.push_back(pi);
+      mapA[a._piList[i]->getGateID()] = Pin(pi, false);
+      mapB[b._piList[piMatch[i]]->getGateID()] = Pin(pi, false);
+   }
+   for(int k = 0; k < 2; k++){
+      const GateList& dfsList = k? b._dfsList: a._dfsList;
+      vector<Pin>& toMiter = k? mapB: mapA;
+      for(size_t i = 0, s = dfsList.size(); i < s; i++){
+         if(!dfsList[i]->isAig()) continue;
+         const vector<Pin>& fanin = dfsList[i]->getFanin();
+         const Pin& f0 = toMiter[fanin[0].getPin()->getGateID()];
+         const Pin& f1 = toMiter[fanin[1].getPin()->getGateID()];
+         CirGate* g = addAig(
+            Pin(f0.getPin(), f0.getInvPhase() ^ fanin[0].getInvPhase()),
+            Pin(f1.getPin(), f1.getInvPhase() ^ fanin[1].getInvPhase()));
+         toMiter[dfsList[i]->getGateID()] = Pin(g, false);
+      }
+   }
+   vector<Pin> xors;
+   for(size_t i = 0, s = a._poList.size(); i < s; i++){
+      const Pin& pa = a._poList[i]->getFanin()[0];
+      const Pin& pb = b._poList[poMatch[i]]->getFanin()[0];
+      const Pin& ma = mapA[pa.getPin()->getGateID()];
+      const Pin& mb = mapB[pb.getPin()->getGateID()];
+      Pin x(ma.getPin(), ma.getInvPhase() ^ pa.getInvPhase());
+      Pin y(mb.getPin(), mb.getInvPhase() ^ pb.getInvPhase());
+      // x ^ y = !(!(x & !y) & !(!x & y))
+      CirGate* t0 = addAig(x, Pin(y.getPin(), !y.getInvPhase()));
+      CirGate* t1 = addAig(Pin(x.getPin(), !x.getInvPhase()), y);
+      xors.push_back(Pin(addAig(Pin(t0, true), Pin(t1, true)), true));
+   }
+   for(size_t i = 0, s = xors.size(); i < s; i++){
+      CirGate* po = new CirPoGate(_totalList.size() * 2);
+      po->setSymbols(a._poList[i]->getSymbols());
+      po->setFanin(xors[i].getPin(), xors[i].getInvPhase());
+      xors[i].getPin()->setFanout(po);
+      _totalList.push_back(po);
+      _poList.push_back(po);
+   }
+   buildDfsList();
+}
@@ -12,19 +12,38 @@
 #include "cirMgr.h"
 #include "cirGate.h"
 #include "cirCmd.h"
+#include "cirEqCache.h"
 #include "util.h"
+#include "myProfile.h"
+#include "myTrace.h"
 
 using namespace std;
 
 extern CirMgr* cirMgr;
 
+// kept across CIRRead so that every circuit can use it
+static CirEqCache eqCache;
+
 bool
 initCirCmd()
 {
-   if (!(cmdMgr->regCmd("CIRRead", 4, new CirReadCmd) &&
-         cmdMgr->regCmd("CIRPrint", 4, new CirPrintCmd) &&
-         cmdMgr->regCmd("CIRGate", 4, new CirGateCmd) &&
-         cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd)
+   if (!(regProfiledCmd("CIRRead", 4, new CirReadCmd) &&
+         regProfiledCmd("CIRPrint", 4, new CirPrintCmd) &&
+         regProfiledCmd("CIRGate", 4, new CirGateCmd) &&
+         regProfiledCmd("CIRWrite", 4, new CirWriteCmd) &&
+         regProfiledCmd("CIRSWeep", 5, new CirSweepCmd) &&
+         regProfiledCmd("CIROPTimize", 6, new CirOptCmd) &&
+         regProfiledCmd("CIRSTRash", 6, new CirStrashCmd) &&
+         regProfiledCmd("CIRCUt", 5, new CirCutCmd) &&
+         regProfiledCmd("CIRREWrite", 6, new CirRewriteCmd) &&
+         regProfiledCmd("CIRBalance", 4, new CirBalanceCmd) &&
+         regProfiledCmd("CIRRESub", 6, new CirResubCmd) &&
+         regProfiledCmd("CIRSIMulate", 6, new CirSimCmd) &&
+         regProfiledCmd("CIRFraig", 4, new CirFraigCmd) &&
+         regProfiledCmd("CIRCEc", 5, new CirCecCmd) &&
+         regProfiledCmd("CIREQCache", 5, new CirEqCacheCmd) &&
+         cmdMgr->regCmd("CIRPROfile", 6, new CirProfileCmd) &&
+         cmdMgr->regCmd("CIRTRace", 5, new CirTraceCmd)
       )) {
       cerr << "Registering \"cir\" commands fails... exiting" << endl;
       return false;
@@ -44,7 +63,7 @@ enum CirCmdState
 static CirCmdState curCmd = CIRINIT;
 
 //----------------------------------------------------------------------
-//    CIRRead <(string fileName)> [-Replace]
+//    CIRRead <(string fileName)> [-Replace] [-Strash]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirReadCmd::exec(const string& option)
@@ -56,13 +75,17 @@ CirReadCmd::exec(const string& option)
    if (options.empty())
       return CmdExec::errorOption(CMD_OPT_MISSING, "");
 
-   bool doReplace = false;
+   bool doReplace = false, doStrash = false;
    string fileName;
    for (size_t i = 0, n = options.size(); i < n; ++i) {
       if (myStrNCmp("-Replace", options[i], 2) == 0) {
          if (doReplace) return CmdExec::errorOption(CMD_OPT_EXTRA,options[i]);
          doReplace = true;
       }
+      else if (myStrNCmp("-Strash", options[i], 2) == 0) {
+         if (doStrash) return CmdExec::errorOption(CMD_OPT_EXTRA,options[i]);
+         doStrash = true;
+      }
       else {
          if (fileName.size())
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
@@ -82,7 +105,7 @@ CirReadCmd::exec(const string& option)
       }
    }
    cirMgr = new CirMgr;
-   if (!cirMgr->readCircuit(fileName)) {
+   if (!cirMgr->readCircuit(fileName, doStrash)) {
       curCmd = CIRINIT;
       delete cirMgr; cirMgr = 0;
       return CMD_EXEC_ERROR;
@@ -96,7 +119,7 @@ CirReadCmd::exec(const string& option)
 void
 CirReadCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRRead <(string fileName)> [-Replace]" << endl;
+   os << "Usage: CIRRead <(string fileName)> [-Replace] [-Strash]" << endl;
 }
 
 void
@@ -107,20 +130,98 @@ CirReadCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRPrint [-Summary | -Netlist | -PI | -PO | -FLoating ]
+//    CIRPrint [-Summary | -Netlist | -PI | -PO | -FLoating | -FECpairs
+//             | -SUPport | -Depth [(int numPOs)] [-Table (string delayFile)]
+//             | -Activity [(int numGates)] [-Random (int nPatterns)
+//                         | -File (string patternFile)] [-CSV (string csvFile)]]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirPrintCmd::exec(const string& option)
 {
    // check option
+   vector<string> options;
    string token;
-   if (!CmdExec::lexSingleOption(option, token))
+   CmdExec::lexOptions(option, options);
+   bool doDepth = !options.empty() && myStrNCmp("-Depth", options[0], 2) == 0;
+   bool doActivity = !options.empty() &&
+                     myStrNCmp("-Activity", options[0], 2) == 0;
+   if (!doDepth && !doActivity && !CmdExec::lexSingleOption(option, token))
       return CMD_EXEC_ERROR;
 
    if (!cirMgr) {
       cerr << "Error: circuit is not yet constructed!!" << endl;
       return CMD_EXEC_ERROR;
    }
+   if (doDepth) {
+      int numPos = 10;
+      bool doNum = false;
+      ifstream delayFile;
+      for (size_t i = 1, n = options.size(); i < n; ++i) {
+         if (myStrNCmp("-Table", options[i], 2) == 0) {
+            if (delayFile.is_open())
+               return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+            if (++i == n)
+               return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+            delayFile.open(options[i].c_str(), ios::in);
+            if (!delayFile)
+               return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         }
+         else if (!doNum && myStr2Int(options[i], numPos) && numPos > 0)
+            doNum = true;
+         else if (doNum)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         else
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      cirMgr->printDepth(numPos, delayFile.is_open()? &delayFile: 0);
+      return CMD_EXEC_DONE;
+   }
+   if (doActivity) {
+      int numGates = 10, nPatterns = CIR_ACTIVITY_PATTERNS;
+      bool doNum = false, doRandom = false;
+      ifstream patternFile;
+      ofstream csvFile;
+      for (size_t i = 1, n = options.size(); i < n; ++i) {
+         if (myStrNCmp("-Random", options[i], 2) == 0) {
+            if (doRandom || patternFile.is_open())
+               return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+            if (++i == n)
+               return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+            if (!myStr2Int(options[i], nPatterns) || nPatterns <= 0)
+               return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+            doRandom = true;
+         }
+         else if (myStrNCmp("-File", options[i], 2) == 0) {
+            if (doRandom || patternFile.is_open())
+               return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+            if (++i == n)
+               return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+            patternFile.open(options[i].c_str(), ios::in);
+            if (!patternFile)
+               return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         }
+         else if (myStrNCmp("-CSV", options[i], 2) == 0) {
+            if (csvFile.is_open())
+               return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+            if (++i == n)
+               return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+            csvFile.open(options[i].c_str(), ios::out);
+            if (!csvFile)
+               return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         }
+         else if (!doNum && myStr2Int(options[i], numGates) && numGates >= 0)
+            doNum = true;
+         else if (doNum)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         else
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      cirMgr->printActivity(numGates, nPatterns,
+                            patternFile.is_open()? &patternFile: 0,
+                            csvFile.is_open()? &csvFile: 0);
+      return CMD_EXEC_DONE;
+   }
+
    if (token.empty() || myStrNCmp("-Summary", token, 2) == 0)
       cirMgr->printSummary();
    else if (myStrNCmp("-Netlist", token, 2) == 0)
@@ -131,10 +232,10 @@ CirPrintCmd::exec(const string& option)
       cirMgr->printPOs();
    else if (myStrNCmp("-FLoating", token, 3) == 0)
       cirMgr->printFloatGates();
-/*
    else if (myStrNCmp("-FECpairs", token, 4) == 0)
       cirMgr->printFECPairs();
-*/
+   else if (myStrNCmp("-SUPport", token, 4) == 0)
+      cirMgr->printSupport();
    else
       return CmdExec::errorOption(CMD_OPT_ILLEGAL, token);
 
@@ -144,10 +245,13 @@ CirPrintCmd::exec(const string& option)
 void
 CirPrintCmd::usage(ostream& os) const
 {  
-   os << "Usage: CIRPrint [-Summary | -Netlist | -PI | -PO | -FLoating]"
-      << endl;
-//   os << "Usage: CIRPrint [-Summary | -Netlist | -PI | -PO | -FLoating "
-//      << "| -FECpairs]" << endl;
+   os << "Usage: CIRPrint [-Summary | -Netlist | -PI | -PO | -FLoating "
+      << "| -FECpairs\n"
+      << "                | -SUPport | -Depth [(int numPOs)] "
+      << "[-Table (string delayFile)]\n"
+      << "                | -Activity [(int numGates)] [-Random (int nPatterns)"
+      << " | -File (string patternFile)]\n"
+      << "                            [-CSV (string csvFile)]]" << endl;
 }
 
 void
@@ -157,7 +261,8 @@ CirPrintCmd::help() const
 }
 
 //----------------------------------------------------------------------
-//    CIRGate <<(int gateId)> [<-FANIn | -FANOut><(int level)>]>
+//    CIRGate <<(int gateId) | (string name)>
+//            [<-FANIn | -FANOut><(int level)> [-Count] | -MFFC]>
 //----------------------------------------------------------------------
 CmdExecStatus
 CirGateCmd::exec(const string& option)
@@ -176,27 +281,39 @@ CirGateCmd::exec(const string& option)
       return CmdExec::errorOption(CMD_OPT_MISSING, "");
 
    int gateId = -1, level = 0;
-   bool doFanin = false, doFanout = false;
+   bool doFanin = false, doFanout = false, doCount = false, doMffc = false;
+   size_t countIdx = 0;
    CirGate* thisGate = 0;
    for (size_t i = 0, n = options.size(); i < n; ++i) {
       bool checkLevel = false;
       if (myStrNCmp("-FANIn", options[i], 5) == 0) {
-         if (doFanin || doFanout)
+         if (doFanin || doFanout || doMffc)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
          doFanin = true;
          checkLevel = true;
       }
       else if (myStrNCmp("-FANOut", options[i], 5) == 0) {
-         if (doFanin || doFanout)
+         if (doFanin || doFanout || doMffc)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
          doFanout = true;
          checkLevel = true;
       }
-      else if (!thisGate) {
-         if (!myStr2Int(options[i], gateId) || gateId < 0)
+      else if (myStrNCmp("-MFFC", options[i], 2) == 0) {
+         if (doFanin || doFanout || doMffc)
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
-         thisGate = cirMgr->getGate(gateId);
+         doMffc = true;
+      }
+      else if (myStrNCmp("-Count", options[i], 2) == 0) {
+         if (doCount)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doCount = true;
+         countIdx = i;
+      }
+      else if (!thisGate) {
+         thisGate = cirMgr->findGate(options[i]);
          if (!thisGate) {
+            if (!myStr2Int(options[i], gateId) || gateId < 0)
+               return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
             cerr << "Error: Gate(" << gateId << ") not found!!" << endl;
             return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[0]);
          }
@@ -218,8 +335,15 @@ CirGateCmd::exec(const string& option)
       cerr << "Error: Gate id is not specified!!" << endl;
       return CmdExec::errorOption(CMD_OPT_MISSING, options.back());
    }
+   if (doCount && !doFanin && !doFanout)
+      return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[countIdx]);
 
-   if (doFanin)
+   if (doMffc)
+      cirMgr->reportMffc(thisGate);
+   else if (doCount)
+      doFanin? thisGate->reportFaninCount(level):
+               thisGate->reportFanoutCount(level);
+   else if (doFanin)
       thisGate->reportFanin(level);
    else if (doFanout)
       thisGate->reportFanout(level);
@@ -232,7 +356,8 @@ CirGateCmd::exec(const string& option)
 void
 CirGateCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRGate <<(int gateId)> [<-FANIn | -FANOut><(int level)>]>"
+   os << "Usage: CIRGate <<(int gateId) | (string name)>"
+      << "\n               [<-FANIn | -FANOut><(int level)> [-Count] | -MFFC]>"
       << endl;
 }
 
@@ -244,7 +369,8 @@ CirGateCmd::help() const
 
 
 //----------------------------------------------------------------------
-//    CIRWrite [-Output (string aagFile)]
+//    CIRWrite [-Gate <(int gateId) | (string name)>...]
+//             [-Output (string aagFile) | -CNF (string cnfFile)]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirWriteCmd::exec(const string& option)
@@ -257,19 +383,58 @@ CirWriteCmd::exec(const string& option)
    vector<string> options;
    CmdExec::lexOptions(option, options);
 
-   if (options.empty())
-      cirMgr->writeAag(cout);
-   else if (myStrNCmp("-Output", options[0], 2) == 0) {
-      if (options.size() == 1)
-         return CmdExec::errorOption(CMD_OPT_MISSING, options[0]);
-      if (options.size() > 2)
-         return CmdExec::errorOption(CMD_OPT_EXTRA, options[2]);
-      ofstream outfile(options[1].c_str(), ios::out);
+   GateList gates;
+   size_t gateIdx = 0, fileIdx = 0;
+   bool doGate = false, doCnf = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Output", options[i], 2) == 0 ||
+          myStrNCmp("-CNF", options[i], 2) == 0) {
+         if (fileIdx)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (i + 1 == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i]);
+         doCnf = (myStrNCmp("-CNF", options[i], 2) == 0);
+         fileIdx = ++i;
+      }
+      else if (myStrNCmp("-Gate", options[i], 2) == 0) {
+         if (doGate)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doGate = true;
+         gateIdx = i;
+         // gates up to the next -Output or -CNF
+         while (i + 1 < n && myStrNCmp("-Output", options[i+1], 2) != 0 &&
+                myStrNCmp("-CNF", options[i+1], 2) != 0) {
+            CirGate* g = cirMgr->findGate(options[++i]);
+            if (!g) {
+               int gateId;
+               if (!myStr2Int(options[i], gateId) || gateId < 0)
+                  return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+               cerr << "Error: Gate(" << gateId << ") not found!!" << endl;
+               return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+            }
+            gates.push_back(g);
+         }
+         if (gates.empty())
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i]);
+      }
+      else if (fileIdx)
+         return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+   if (doGate && doCnf)
+      return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[gateIdx]);
+
+   ofstream outfile;
+   if (fileIdx) {
+      outfile.open(options[fileIdx].c_str(), ios::out);
       if (!outfile)
-         return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[1]);
-      cirMgr->writeAag(outfile);
+         return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[fileIdx]);
    }
-   else return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[0]);
+   ostream& os = fileIdx? (ostream&)outfile: cout;
+   if (doGate) cirMgr->writeCone(os, gates);
+   else if (doCnf) cirMgr->writeCnf(os);
+   else cirMgr->writeAag(os);
 
    return CMD_EXEC_DONE;
 }
@@ -277,7 +442,9 @@ CirWriteCmd::exec(const string& option)
 void
 CirWriteCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRWrite [-Output (string aagFile)]" << endl;
+   os << "Usage: CIRWrite [-Gate <(int gateId) | (string name)>...]\n"
+      << "                [-Output (string aagFile) | -CNF (string cnfFile)]"
+      << endl;
 }
 
 void
@@ -285,4 +452,643 @@ CirWriteCmd::help() const
 {
    cout << setw(15) << left << "CIRWrite: "
         << "write the netlist to an ASCII AIG file (.aag)\n";
-}
\ No newline at end of file
+}
+
+//----------------------------------------------------------------------
+//    CIRSWeep [-Compact]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirSweepCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   string token;
+   if (!CmdExec::lexSingleOption(option, token))
+      return CMD_EXEC_ERROR;
+
+   bool doCompact = false;
+   if (token.size()) {
+      if (myStrNCmp("-Compact", token, 2) == 0) doCompact = true;
+      else return CmdExec::errorOption(CMD_OPT_ILLEGAL, token);
+   }
+   cirMgr->sweep(doCompact);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirSweepCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSWeep [-Compact]" << endl;
+}
+
+void
+CirSweepCmd::help() const
+{
+   cout << setw(15) << left << "CIRSWeep: "
+        << "remove unused gates\n";
+}
+
+//----------------------------------------------------------------------
+//    CIROPTimize
+//----------------------------------------------------------------------
+CmdExecStatus
+CirOptCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   cirMgr->optimize();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirOptCmd::usage(ostream& os) const
+{
+   os << "Usage: CIROPTimize" << endl;
+}
+
+void
+CirOptCmd::help() const
+{
+   cout << setw(15) << left << "CIROPTimize: "
+        << "perform trivial optimizations\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRSTRash
+//----------------------------------------------------------------------
+CmdExecStatus
+CirStrashCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   cirMgr->strash();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirStrashCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSTRash" << endl;
+}
+
+void
+CirStrashCmd::help() const
+{
+   cout << setw(15) << left << "CIRSTRash: "
+        << "perform structural hash on the circuit netlist\n";
+}
+
+
+//----------------------------------------------------------------------
+//    CIRCUt [-K (int cutSize)] [-P (int numCuts)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirCutCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   int k = 4, p = 8;
+   bool doK = false, doP = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* val = 0;
+      if (myStrNCmp("-K", options[i], 2) == 0) {
+         if (doK) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doK = true; val = &k;
+      }
+      else if (myStrNCmp("-P", options[i], 2) == 0) {
+         if (doP) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doP = true; val = &p;
+      }
+      else return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *val) || *val < 1)
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+   if (k > 6) return CmdExec::errorOption(CMD_OPT_ILLEGAL, to_string(k));
+
+   cirMgr->printCuts(k, p);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirCutCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRCUt [-K (int cutSize)] [-P (int numCuts)]" << endl;
+}
+
+void
+CirCutCmd::help() const
+{
+   cout << setw(15) << left << "CIRCUt: "
+        << "enumerate k-feasible priority cuts\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRREWrite
+//----------------------------------------------------------------------
+CmdExecStatus
+CirRewriteCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   cirMgr->rewrite();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirRewriteCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRREWrite" << endl;
+}
+
+void
+CirRewriteCmd::help() const
+{
+   cout << setw(15) << left << "CIRREWrite: "
+        << "rewrite 4-input cuts with smaller NPN implementations\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRBalance
+//----------------------------------------------------------------------
+CmdExecStatus
+CirBalanceCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   cirMgr->balance();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirBalanceCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRBalance" << endl;
+}
+
+void
+CirBalanceCmd::help() const
+{
+   cout << setw(15) << left << "CIRBalance: "
+        << "balance AND supergates to reduce the circuit depth\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRRESub [-Leaves (int nLeaves)] [-Thread (int nThreads)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirResubCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   int nLeaves = CIR_RESUB_LEAVES, nThreads = 1;
+   bool doLeaves = false, doThread = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* val = 0;
+      if (myStrNCmp("-Leaves", options[i], 2) == 0) {
+         if (doLeaves) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doLeaves = true; val = &nLeaves;
+      }
+      else if (myStrNCmp("-Thread", options[i], 2) == 0) {
+         if (doThread) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doThread = true; val = &nThreads;
+      }
+      else return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *val) || *val < 1 ||
+          (val == &nLeaves && (*val < 2 || *val > CIR_RESUB_MAX_LEAVES)))
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   cirMgr->resub(nLeaves, nThreads);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirResubCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRRESub [-Leaves (int nLeaves)] [-Thread (int nThreads)]"
+      << endl;
+}
+
+void
+CirResubCmd::help() const
+{
+   cout << setw(15) << left << "CIRRESub: "
+        << "re-express gates with divisors from their windows\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRSIMulate <-Random | -File <string patternFile>>
+//                [-Output <string logFile>]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirSimCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+   ifstream patternFile;
+   ofstream logFile;
+   bool doRandom = false, doFile = false, doLog = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Random", options[i], 2) == 0) {
+         if (doRandom || doFile)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doRandom = true;
+      }
+      else if (myStrNCmp("-File", options[i], 2) == 0) {
+         if (doRandom || doFile)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         patternFile.open(options[i].c_str(), ios::in);
+         if (!patternFile)
+            return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         doFile = true;
+      }
+      else if (myStrNCmp("-Output", options[i], 2) == 0) {
+         if (doLog)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         logFile.open(options[i].c_str(), ios::out);
+         if (!logFile)
+            return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[i]);
+         doLog = true;
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   if (!doRandom && !doFile)
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   assert (!(doRandom && doFile));
+   if (doLog)
+      cirMgr->setSimLog(&logFile);
+   else cirMgr->setSimLog(0);
+
+   if (doRandom)
+      cirMgr->randomSim();
+   else
+      cirMgr->fileSim(patternFile);
+   cirMgr->setSimLog(0);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirSimCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRSIMulate <-Random | -File <string patternFile>>\n"
+      << "                   [-Output <string logFile>]" << endl;
+}
+
+void
+CirSimCmd::help() const
+{
+   cout << setw(15) << left << "CIRSIMulate: "
+        << "perform Boolean logic simulation on the circuit\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRFraig [-Thread (int numThreads)] [-Conflict (int maxConflicts)]
+//             [-TIme (int seconds)] [-Bdd (int maxSupport)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirFraigCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   int nThreads = 1, nConflicts = CIR_FRAIG_CONFLICTS, nSeconds = 0;
+   int maxSupport = CIR_FRAIG_BDD_SUPPORT;
+   bool doThread = false, doConflict = false, doTime = false, doBdd = false;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      int* val = 0;
+      if (myStrNCmp("-Thread", options[i], 2) == 0) {
+         if (doThread) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doThread = true; val = &nThreads;
+      }
+      else if (myStrNCmp("-Conflict", options[i], 2) == 0) {
+         if (doConflict)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doConflict = true; val = &nConflicts;
+      }
+      else if (myStrNCmp("-TIme", options[i], 3) == 0) {
+         if (doTime) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doTime = true; val = &nSeconds;
+      }
+      else if (myStrNCmp("-Bdd", options[i], 2) == 0) {
+         if (doBdd) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doBdd = true; val = &maxSupport;
+      }
+      else return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      if (++i == n)
+         return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+      if (!myStr2Int(options[i], *val) || *val < 0 ||
+          (val == &nThreads && *val == 0))
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+
+   cirMgr->setFraigBudget(nConflicts, nSeconds);
+   cirMgr->setFraigBdd(maxSupport);
+   cirMgr->setEqCache(eqCache.isOpen()? &eqCache: 0);
+   cirMgr->fraig(nThreads);
+   if (eqCache.isOpen() && !eqCache.save())
+      return CMD_EXEC_ERROR;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirFraigCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRFraig [-Thread (int numThreads)] "
+      << "[-Conflict (int maxConflicts)]\n"
+      << "                [-TIme (int seconds)] [-Bdd (int maxSupport)]"
+      << endl;
+}
+
+void
+CirFraigCmd::help() const
+{
+   cout << setw(15) << left << "CIRFraig: "
+        << "perform FRAIG operation on the circuit\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRCEc <(string fileName)> [-Name] [-Thread (int numThreads)]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirCecCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+   if (options.empty())
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   bool byName = false, doThread = false;
+   int nThreads = 1;
+   string fileName;
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Name", options[i], 2) == 0) {
+         if (byName) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         byName = true;
+      }
+      else if (myStrNCmp("-Thread", options[i], 2) == 0) {
+         if (doThread) return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         doThread = true;
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (!myStr2Int(options[i], nThreads) || nThreads < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      else {
+         if (fileName.size())
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         fileName = options[i];
+      }
+   }
+   if (fileName.empty())
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   CirMgr* other = new CirMgr;
+   if (!other->readCircuit(fileName)) {
+      delete other;
+      return CMD_EXEC_ERROR;
+   }
+   cirMgr->cec(*other, byName, nThreads);
+   delete other;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirCecCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRCEc <(string fileName)> [-Name] [-Thread (int numThreads)]"
+      << endl;
+}
+
+void
+CirCecCmd::help() const
+{
+   cout << setw(15) << left << "CIRCEc: "
+        << "check equivalence against another circuit\n";
+}
+
+//----------------------------------------------------------------------
+//    CIREQCache [(string fileName) | -Close]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirEqCacheCmd::exec(const string& option)
+{
+   string token;
+   if (!CmdExec::lexSingleOption(option, token))
+      return CMD_EXEC_ERROR;
+
+   if (token.empty()) {
+      if (!eqCache.isOpen())
+         cout << "No equivalence cache is open." << endl;
+      else
+         cout << "Equivalence cache \"" << eqCache.getFileName() << "\": "
+              << eqCache.getNumEntries() << " result(s)" << endl;
+      return CMD_EXEC_DONE;
+   }
+   if (myStrNCmp("-Close", token, 2) == 0) {
+      if (!eqCache.isOpen()) {
+         cerr << "Error: no equivalence cache is open!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      bool saved = eqCache.save();
+      eqCache.close();
+      return saved? CMD_EXEC_DONE: CMD_EXEC_ERROR;
+   }
+   if (eqCache.isOpen() && !eqCache.save())
+      return CMD_EXEC_ERROR;
+   if (!eqCache.open(token))
+      return CMD_EXEC_ERROR;
+   cout << "Equivalence cache \"" << eqCache.getFileName() << "\": "
+        << eqCache.getNumEntries() << " result(s)" << endl;
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirEqCacheCmd::usage(ostream& os) const
+{
+   os << "Usage: CIREQCache [(string fileName) | -Close]" << endl;
+}
+
+void
+CirEqCacheCmd::help() const
+{
+   cout << setw(15) << left << "CIREQCache: "
+        << "open the persistent cache of equivalence results\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRPROfile [-ON | -OFF | -Reset]
+//----------------------------------------------------------------------
+CmdExecStatus
+CirProfileCmd::exec(const string& option)
+{
+   string token;
+   if (!CmdExec::lexSingleOption(option, token))
+      return CMD_EXEC_ERROR;
+
+   if (token.empty()) {
+      if (!myProfile.isUsed())
+         cout << "Profiling is off; turn it on by \"CIRPROfile -ON\"." << endl;
+      else myProfile.report(cout);
+   }
+   else if (myStrNCmp("-ON", token, 3) == 0)
+      myProfile.enable(true);
+   else if (myStrNCmp("-OFF", token, 3) == 0)
+      myProfile.enable(false);
+   else if (myStrNCmp("-Reset", token, 2) == 0)
+      myProfile.reset();
+   else
+      return CmdExec::errorOption(CMD_OPT_ILLEGAL, token);
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirProfileCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRPROfile [-ON | -OFF | -Reset]" << endl;
+}
+
+void
+CirProfileCmd::help() const
+{
+   cout << setw(15) << left << "CIRPROfile: "
+        << "report the time and memory used by each command\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRTRace <-ON | -OFF | -Output (string jsonFile)>
+//----------------------------------------------------------------------
+CmdExecStatus
+CirTraceCmd::exec(const string& option)
+{
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+   if (options.empty())
+      return CmdExec::errorOption(CMD_OPT_MISSING, "");
+
+   bool doOn = myStrNCmp("-ON", options[0], 3) == 0;
+   bool doOff = myStrNCmp("-OFF", options[0], 3) == 0;
+   bool doOutput = myStrNCmp("-Output", options[0], 2) == 0;
+   if (!doOn && !doOff && !doOutput)
+      return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[0]);
+   if (doOutput && options.size() == 1)
+      return CmdExec::errorOption(CMD_OPT_MISSING, options[0]);
+   if (options.size() > (doOutput? 2: 1))
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[doOutput? 2: 1]);
+#ifdef MY_TRACE
+   if (doOutput) {
+      ofstream outfile(options[1].c_str(), ios::out);
+      if (!outfile)
+         return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, options[1]);
+      myTrace.dump(outfile);
+      cout << myTrace.getNumSpans() << " span(s) written to \""
+           << options[1] << "\"." << endl;
+   }
+   else myTrace.enable(doOn);
+   return CMD_EXEC_DONE;
+#else
+   cerr << "Error: tracing is not built in; rebuild with \"make TRACE=1\"!!"
+        << endl;
+   return CMD_EXEC_ERROR;
+#endif
+}
+
+void
+CirTraceCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRTRace <-ON | -OFF | -Output (string jsonFile)>" << endl;
+}
+
+void
+CirTraceCmd::help() const
+{
+   cout << setw(15) << left << "CIRTRace: "
+        << "record the phases of the engine for a trace viewer\n";
+}
@@ -15,5 +15,18 @@ CmdClass(CirReadCmd);
 CmdClass(CirPrintCmd);
 CmdClass(CirGateCmd);
 CmdClass(CirWriteCmd);
+CmdClass(CirSweepCmd);
+CmdClass(CirOptCmd);
+CmdClass(CirStrashCmd);
+CmdClass(CirCutCmd);
+CmdClass(CirRewriteCmd);
+CmdClass(CirBalanceCmd);
+CmdClass(CirResubCmd);
+CmdClass(CirSimCmd);
+CmdClass(CirFraigCmd);
+CmdClass(CirCecCmd);
+CmdClass(CirEqCacheCmd);
+CmdClass(CirProfileCmd);
+CmdClass(CirTraceCmd);
 
 #endif // CIR_CMD_H
@@ -0,0 +1,251 @@
+/****************************************************************************
+  FileName     [ cirCut.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define k-feasible priority cut enumeration ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+#include <ctime>
+#include "cirCut.h"
+#include "cirGate.h"
+#include "cirMgr.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static const uint64_t varTruth[CUT_MAX_K] = {
+   0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+   0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+};
+
+// masks to swap variable v and v+1: (keep, move up, move down)
+static const uint64_t swapMask[CUT_MAX_K - 1][3] = {
+   { 0x9999999999999999ULL, 0x2222222222222222ULL, 0x4444444444444444ULL },
+   { 0xC3C3C3C3C3C3C3C3ULL, 0x0C0C0C0C0C0C0C0CULL, 0x3030303030303030ULL },
+   { 0xF00FF00FF00FF00FULL, 0x00F000F000F000F0ULL, 0x0F000F000F000F00ULL },
+   { 0xFF0000FFFF0000FFULL, 0x0000FF000000FF00ULL, 0x00FF000000FF0000ULL },
+   { 0xFFFF00000000FFFFULL, 0x00000000FFFF0000ULL, 0x0000FFFF00000000ULL }
+};
+
+static inline uint64_t
+swapAdjacent(uint64_t t, unsigned v)
+{
+   unsigned shift = 1u << v;
+   return (t & swapMask[v][0]) | ((t & swapMask[v][1]) << shift)
+        | ((t & swapMask[v][2]) >> shift);
+}
+
+static inline unsigned
+countOnes(uint64_t x)
+{
+   return __builtin_popcountll(x);
+}
+
+// "sub" and "sup" are sorted
+static bool
+isSubset(const unsigned* sub, unsigned nSub, const unsigned* sup, unsigned nSup)
+{
+   unsigned j = 0;
+   for(unsigned i = 0; i < nSub; i++){
+      while(j < nSup && sup[j] < sub[i]) j++;
+      if(j == nSup || sup[j] != sub[i]) return false;
+   }
+   return true;
+}
+
+// merge two sorted leaf sets; return false if the union exceeds "k"
+static bool
+mergeLeaves(const unsigned* a, unsigned na, const unsigned* b, unsigned nb,
+            unsigned* c, unsigned& nc, unsigned k)
+{
+   unsigned i = 0, j = 0;
+   nc = 0;
+   while(i < na || j < nb){
+      if(nc == k) return false;
+      if(j == nb || (i < na && a[i] < b[j])) c[nc++] = a[i++];
+      else if(i == na || b[j] < a[i]) c[nc++] = b[j++];
+      else { c[nc++] = a[i++]; j++; }
+   }
+   return true;
+}
+
+/*****************************************/
+/*   class CirCutMgr member functions    */
+/*****************************************/
+CirCutMgr::CirCutMgr(unsigned k, unsigned p)
+   : _k(k), _p(p), _totalCuts(0), _nNodes(0)
+{
+   assert(k >= 1 && k <= CUT_MAX_K && p >= 1);
+}
+
+uint64_t
+CirCutMgr::getVarTruth(unsigned i)
+{
+   assert(i < CUT_MAX_K);
+   return varTruth[i];
+}
+
+// Re-express truth table "t" over leaves "from" as one over "to" (from is a
+// subset of to, both sorted): move each variable up to its new position,
+// starting from the topmost one.
+uint64_t
+CirCutMgr::stretchTruth(uint64_t t, const unsigned* from, unsigned nFrom,
+                        const unsigned* to, unsigned nTo)
+{
+   unsigned j = nTo;
+   for(int i = nFrom - 1; i >= 0; i--){
+      while(to[--j] != from[i]) assert(j > 0);
+      for(unsigned v = i; v < j; v++) t = swapAdjacent(t, v);
+   }
+   return t;
+}
+
+void
+CirCutMgr::enumerate(const GateList& totalList, const GateList& dfsList)
+{
+   size_t n = totalList.size();
+   _cuts.assign(n * (_p + 1), CirCut());
+   _leafPool.assign(n * (_p + 1) * _k, 0);
+   _nCuts.assign(n, 0);
+   _level.assign(n, 0);
+   _totalCuts = _nNodes = 0;
+   for(size_t i = 0; i < n; i++)
+      if(totalList[i] != 0) setTrivial(totalList[i]);
+   for(size_t i = 0, s = dfsList.size(); i < s; i++)
+      if(dfsList[i]->isAig()) enumerateGate(dfsList[i]);
+}
+
+void
+CirCutMgr::setTrivial(const CirGate* g)
+{
+   unsigned id = g->getGateID();
+   CirCut& cut = cutSlot(id, 0);
+   cut._level = _level[id];
+   if(g->getType() == CONST_GATE){
+      cut._nLeaves = 0; cut._sign = 0; cut._truth = 0;
+   }else{
+      cut._nLeaves = 1; cut._sign = uint64_t(1) << (id % 64);
+      cut._truth = varTruth[0];
+      leafSlot(id, 0)[0] = id;
+   }
+   _nCuts[id] = 1;
+}
+
+// Priority: fewer leaves first, then shallower leaves. Candidates are kept
+// sorted in slots 1.._nCuts-1 of the gate itself.
+void
+CirCutMgr::enumerateGate(const CirGate* g)
+{
+   unsigned id = g->getGateID();
+   const Pin& p0 = g->getFanin()[0];
+   const Pin& p1 = g->getFanin()[1];
+   unsigned id0 = p0.getPin()->getGateID(), id1 = p1.getPin()->getGateID();
+   _level[id] = max(_level[id0], _level[id1]) + 1;
+   unsigned nCand = 0;
+   unsigned leaves[CUT_MAX_K], nLeaves;
+   for(unsigned i = 0, n0 = _nCuts[id0]; i < n0; i++){
+      const CirCut& c0 = getCut(id0, i);
+      const unsigned* l0 = getLeaves(id0, i);
+      for(unsigned j = 0, n1 = _nCuts[id1]; j < n1; j++){
+         const CirCut& c1 = getCut(id1, j);
+         uint64_t sign = c0._sign | c1._sign;
+         if(countOnes(sign) > _k) continue;
+         const unsigned* l1 = getLeaves(id1, j);
+         if(!mergeLeaves(l0, c0._nLeaves, l1, c1._nLeaves, leaves, nLeaves, _k))
+            continue;
+         unsigned level = 0;
+         for(unsigned l = 0; l < nLeaves; l++)
+            level = max(level, _level[leaves[l]]);
+         // dominance filtering, both ways
+         bool dominated = false;
+         for(unsigned c = 1; c <= nCand && !dominated; ){
+            CirCut& o = cutSlot(id, c);
+            if(o._nLeaves <= nLeaves && (o._sign & sign) == o._sign &&
+               isSubset(leafSlot(id, c), o._nLeaves, leaves, nLeaves))
+               dominated = true;
+            else if(nLeaves < o._nLeaves && (o._sign & sign) == sign &&
+               isSubset(leaves, nLeaves, leafSlot(id, c), o._nLeaves)){
+               // drop "o" by shifting the rest down
+               for(unsigned d = c; d < nCand; d++){
+                  cutSlot(id, d) = cutSlot(id, d + 1);
+                  copy(leafSlot(id, d + 1), leafSlot(id, d + 1) + _k,
+                       leafSlot(id, d));
+               }
+               --nCand;
+            }
+            else ++c;
+         }
+         if(dominated) continue;
+         // find the insert position; drop the candidate if it ranks last
+         unsigned pos = nCand + 1;
+         while(pos > 1){
+            const CirCut& o = cutSlot(id, pos - 1);
+            if(o._nLeaves < nLeaves ||
+               (o._nLeaves == nLeaves && o._level <= level)) break;
+            --pos;
+         }
+         if(pos > _p) continue;
+         if(nCand < _p) ++nCand;
+         for(unsigned d = nCand; d > pos; d--){
+            cutSlot(id, d) = cutSlot(id, d - 1);
+            copy(leafSlot(id, d - 1), leafSlot(id, d - 1) + _k, leafSlot(id, d));
+         }
+         uint64_t t0 = stretchTruth(c0._truth, l0, c0._nLeaves, leaves, nLeaves);
+         uint64_t t1 = stretchTruth(c1._truth, l1, c1._nLeaves, leaves, nLeaves);
+         if(p0.getInvPhase()) t0 = ~t0;
+         if(p1.getInvPhase()) t1 = ~t1;
+         CirCut& cut = cutSlot(id, pos);
+         cut._nLeaves = nLeaves; cut._level = level;
+         cut._sign = sign; cut._truth = t0 & t1;
+         copy(leaves, leaves + nLeaves, leafSlot(id, pos));
+      }
+   }
+   CirCut& triv = cutSlot(id, 0);
+   triv._level = _level[id];
+   _nCuts[id] = nCand + 1;
+   _totalCuts += nCand;
+   ++_nNodes;
+}
+
+size_t
+CirCutMgr::getMemUsage() const
+{
+   return _cuts.capacity() * sizeof(CirCut)
+        + _leafPool.capacity() * sizeof(unsigned)
+        + (_nCuts.capacity() + _level.capacity()) * sizeof(unsigned);
+}
+
+void
+CirCutMgr::reportStats(double seconds) const
+{
+   cout << "Cuts (K = " << _k << ", P = " << _p << "): " << _totalCuts
+        << " on " << _nNodes << " AIG(s), " << fixed << setprecision(2)
+        << (_nNodes? double(_totalCuts) / _nNodes: 0.0) << " per node" << endl;
+   cout << "Time: " << setprecision(4) << seconds << " seconds";
+   if(seconds > 0)
+      cout << " (" << setprecision(0) << _totalCuts / seconds << " cuts/s)";
+   cout << endl;
+   cout << "Memory: " << setprecision(2) << getMemUsage() / double(1 << 20)
+        << " M Bytes" << endl;
+   cout.unsetf(ios::fixed);
+   cout << setprecision(6);
+}
+
+/*****************************************/
+/*   Public member functions about cuts  */
+/*****************************************/
+void
+CirMgr::printCuts(unsigned k, unsigned p) const
+{
+   CirCutMgr cutMgr(k, p);
+   clock_t start = clock();
+   cutMgr.enumerate(_totalList, _dfsList);
+   cutMgr.reportStats(double(clock() - start) / CLOCKS_PER_SEC);
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+  FileName     [ cirCut.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define k-feasible priority cut enumeration ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_CUT_H
+#define CIR_CUT_H
+
+#include <vector>
+#include <stdint.h>
+#include "cirDef.h"
+
+using namespace std;
+
+#define CUT_MAX_K   6
+
+//------------------------------------------------------------------------
+//   class CirCut
+//------------------------------------------------------------------------
+// Leaves are kept in CirCutMgr's arena; a cut only carries what is needed
+// to filter and rank it, plus its function over the (sorted) leaves.
+class CirCut
+{
+public:
+  CirCut(): _nLeaves(0), _level(0), _sign(0), _truth(0) {}
+
+  unsigned size() const { return _nLeaves; }
+  unsigned getLevel() const { return _level; }
+  uint64_t getSign() const { return _sign; }
+  uint64_t getTruth() const { return _truth; }
+
+private:
+  friend class CirCutMgr;
+
+  unsigned  _nLeaves;
+  unsigned  _level;   // max level of the leaves
+  uint64_t  _sign;    // OR of (1 << (leaf % 64))
+  uint64_t  _truth;   // leaf i is variable i
+};
+
+//------------------------------------------------------------------------
+//   class CirCutMgr
+//------------------------------------------------------------------------
+// Keeps the trivial cut (slot 0) plus the best "P" cuts of every gate,
+// indexed by gate ID. Leaves of slot c of gate g live at
+// _leafPool[(g * (P+1) + c) * K], so the arena is allocated only once.
+class CirCutMgr
+{
+public:
+  CirCutMgr(unsigned k = 4, unsigned p = 8);
+  ~CirCutMgr() {}
+
+  void enumerate(const GateList& totalList, const GateList& dfsList);
+
+  unsigned getK() const { return _k; }
+  unsigned getNumCuts(unsigned gid) const { return _nCuts[gid]; }
+  const CirCut& getCut(unsigned gid, unsigned c) const
+    { return _cuts[gid * (_p + 1) + c]; }
+  const unsigned* getLeaves(unsigned gid, unsigned c) const
+    { return &_leafPool[(gid * (_p + 1) + c) * _k]; }
+  unsigned getLevel(unsigned gid) const { return _level[gid]; }
+
+  size_t getTotalCuts() const { return _totalCuts; }
+  size_t getMemUsage() const;
+  void reportStats(double seconds) const;
+
+  static uint64_t getVarTruth(unsigned i);
+  static uint64_t stretchTruth(uint64_t, const unsigned*, unsigned,
+                               const unsigned*, unsigned);
+
+private:
+  unsigned             _k;
+  unsigned             _p;
+  vector<CirCut>       _cuts;
+  vector<unsigned>     _leafPool;
+  vector<unsigned>     _nCuts;
+  vector<unsigned>     _level;
+  size_t               _totalCuts;
+  size_t               _nNodes;
+
+  CirCut& cutSlot(unsigned gid, unsigned c)
+    { return _cuts[gid * (_p + 1) + c]; }
+  unsigned* leafSlot(unsigned gid, unsigned c)
+    { return &_leafPool[(gid * (_p + 1) + c) * _k]; }
+
+  void setTrivial(const CirGate*);
+  void enumerateGate(const CirGate*);
+};
+
+#endif // CIR_CUT_H
@@ -15,6 +15,11 @@ using namespace std;
 
 class CirGate;
 class CirMgr;
+class Pin;
+class StrashTable;
+class BddMgr;
+class BddNode;
+class CirEqCache;
 
 typedef vector<CirGate*>           GateList;
 typedef vector<unsigned>           IdList;
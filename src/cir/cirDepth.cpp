@@ -0,0 +1,131 @@
+/****************************************************************************
+  FileName     [ cirDepth.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define arrival time and critical path report ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// One "<type> <delay>" per line, where type is PI (arrival time), PO, AIG
+// or INV (an inverted fanin edge); '#' starts a comment. Types that are
+// not listed keep the unit-delay model: 1 for AIG and 0 for the others.
+static bool
+readDelayTable(istream& is, double typeDelay[TOT_GATE], double& invDelay)
+{
+   string line;
+   for(unsigned lineNo = 1; getline(is, line); lineNo++){
+      size_t c = line.find('#');
+      if(c != string::npos) line.erase(c);
+      istringstream iss(line);
+      string type, extra;
+      double d;
+      if(!(iss >> type)) continue;
+      if(!(iss >> d) || (iss >> extra) || d < 0){
+         cerr << "Error: illegal delay in line " << lineNo << " of the delay "
+              << "table!!" << endl;
+         return false;
+      }
+      if(myStrNCmp("PI", type, 2) == 0) typeDelay[PI_GATE] = d;
+      else if(myStrNCmp("PO", type, 2) == 0) typeDelay[PO_GATE] = d;
+      else if(myStrNCmp("AIG", type, 3) == 0) typeDelay[AIG_GATE] = d;
+      else if(myStrNCmp("INV", type, 3) == 0) invDelay = d;
+      else{
+         cerr << "Error: unknown gate type \"" << type << "\" in line "
+              << lineNo << " of the delay table!!" << endl;
+         return false;
+      }
+   }
+   return true;
+}
+
+struct ArrivalGreater
+{
+   ArrivalGreater(const vector<double>& t): _arrival(t) {}
+   bool operator() (const CirGate* a, const CirGate* b) const {
+      return _arrival[a->getGateID()] > _arrival[b->getGateID()];
+   }
+   const vector<double>& _arrival;
+};
+
+/*******************************************/
+/*   Public member functions about depth   */
+/*******************************************/
+// Arrival times in one pass over _dfsList; then the "numPos" latest POs,
+// each with one critical path traced back to a PI (or CONST/UNDEF)
+void
+CirMgr::printDepth(unsigned numPos, istream* delayTable) const
+{
+   double typeDelay[TOT_GATE] = { 0 };
+   double invDelay = 0;
+   typeDelay[AIG_GATE] = 1;
+   if(delayTable && !readDelayTable(*delayTable, typeDelay, invDelay))
+      return;
+
+   vector<double> arrival(_totalList.size(), 0);
+   for(size_t i = 0, s = _dfsList.size(); i < s; i++){
+      const CirGate* g = _dfsList[i];
+      const vector<Pin>& fanin = g->getFanin();
+      double t = 0;
+      for(size_t j = 0, n = fanin.size(); j < n; j++)
+         t = max(t, arrival[fanin[j].getPin()->getGateID()] +
+                    (fanin[j].getInvPhase()? invDelay: 0));
+      arrival[g->getGateID()] = t + typeDelay[g->getType()];
+   }
+
+   GateList order(_poList);
+   stable_sort(order.begin(), order.end(), ArrivalGreater(arrival));
+   if(order.size() > numPos) order.resize(numPos);
+
+   ostringstream oss;
+   vector<string> path;
+   for(size_t i = 0, s = order.size(); i < s; i++){
+      const CirGate* g = order[i];
+      oss << "PO " << g->getGateID();
+      if(!g->getSymbols().empty()) oss << " (" << g->getSymbols() << ")";
+      oss << ": depth " << arrival[g->getGateID()] << "\n ";
+      // back to the source through the latest fanin, printed PI first
+      path.clear();
+      bool inv = false;
+      while(true){
+         ostringstream node;
+         node << (inv? "!": "") << (g->getType() == CONST_GATE? "CONST":
+                 g->getTypeStr()) << " " << g->getGateID() << " ("
+              << arrival[g->getGateID()] << ")";
+         path.push_back(node.str());
+         const vector<Pin>& fanin = g->getFanin();
+         if(fanin.empty()) break;
+         size_t k = 0;
+         double t = -1;
+         for(size_t j = 0, n = fanin.size(); j < n; j++){
+            double tj = arrival[fanin[j].getPin()->getGateID()] +
+                        (fanin[j].getInvPhase()? invDelay: 0);
+            if(tj > t) { t = tj; k = j; }
+         }
+         inv = fanin[k].getInvPhase();
+         g = fanin[k].getPin();
+      }
+      for(size_t j = path.size(); j > 0; j--)
+         oss << " " << path[j - 1] << (j > 1? " ->": "\n");
+   }
+   cout << oss.str();
+
+   double maxDepth = 0;
+   for(size_t i = 0, s = _poList.size(); i < s; i++)
+      maxDepth = max(maxDepth, arrival[_poList[i]->getGateID()]);
+   cout << "Depth: max " << maxDepth << " over " << _poList.size()
+        << " PO(s), " << order.size() << " reported ("
+        << (delayTable? "delay table": "unit delay") << ")" << endl;
+}
@@ -0,0 +1,154 @@
+/****************************************************************************
+  FileName     [ cirDom.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define dominators and maximum fanout-free cones ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/*********************************************************/
+/*   Public member functions about dominators and MFFC   */
+/*********************************************************/
+// The gate that every path from "g" to a PO passes through first; '0' if
+// only the set of POs does (a PO, or a gate reaching several POs
+// separately), or if "g" reaches no PO at all
+CirGate*
+CirMgr::getDominator(const CirGate* g)
+{
+   if(_idom.empty()) buildDominators();
+   return _idom[g->getGateID()];
+}
+
+// Number of AIGs that lose all their fanouts once "g" is removed, "g"
+// itself included. "cone" (if any) gets these AIGs.
+unsigned
+CirMgr::getMffcSize(const CirGate* g, GateList* cone)
+{
+   if(_mffcRef.empty()) buildMffcRefs();
+   unsigned n = derefMffc(g, cone);
+   refMffc(g);
+   return n;
+}
+
+void
+CirMgr::reportMffc(const CirGate* g)
+{
+   GateList cone;
+   unsigned n = getMffcSize(g, &cone);
+   IdList ids;
+   for(size_t i = 0, s = cone.size(); i < s; i++)
+      ids.push_back(cone[i]->getGateID());
+   sort(ids.begin(), ids.end());
+   ostringstream oss;
+   oss << "MFFC of " << g->getTypeStr() << " " << g->getGateID() << ": "
+       << n << " AIG(s)";
+   if(!ids.empty()) oss << ":";
+   for(size_t i = 0, s = ids.size(); i < s; i++) oss << " " << ids[i];
+   oss << "\nDominators:";
+   const CirGate* d = getDominator(g);
+   if(d == 0) oss << " none but the POs";
+   for(; d != 0; d = getDominator(d))
+      oss << " " << d->getTypeStr() << " " << d->getGateID()
+          << (getDominator(d)? " ->": "");
+   cout << oss.str() << endl;
+}
+
+/**********************************************************/
+/*   Private member functions about dominators and MFFC   */
+/**********************************************************/
+// Immediate dominators on the reversed graph, rooted at a virtual sink
+// that all POs feed. _dfsList is topological, so visiting it backwards
+// sees every fanout of a gate before the gate itself, and a single pass of
+// "intersect the dominators of all fanouts" is exact (no iteration as
+// needed on cyclic graphs, and no semi-dominators as in Lengauer-Tarjan).
+void
+CirMgr::buildDominators()
+{
+   size_t n = _dfsList.size();
+   const unsigned root = n, none = n + 1;
+   vector<unsigned> order(_totalList.size(), none);   // ID -> DFS index
+   for(size_t i = 0; i < n; i++) order[_dfsList[i]->getGateID()] = i;
+   vector<unsigned> idom(n + 1, root);
+   for(size_t i = n; i > 0; i--){
+      const CirGate* g = _dfsList[i - 1];
+      const vector<Pin>& fanout = g->getFanout();
+      unsigned d = none;
+      for(size_t j = 0, m = fanout.size(); j < m; j++){
+         unsigned f = order[fanout[j].getPin()->getGateID()];
+         if(f == none) continue;   // fanout reaching no PO
+         if(d == none) { d = f; continue; }
+         // walk both up the (partial) tree to their nearest common dominator
+         while(d != f){
+            while(d < f) d = idom[d];
+            while(f < d) f = idom[f];
+         }
+      }
+      idom[i - 1] = (d == none)? root: d;
+   }
+   _idom.assign(_totalList.size(), 0);
+   for(size_t i = 0; i < n; i++)
+      if(idom[i] != root)
+         _idom[_dfsList[i]->getGateID()] = _dfsList[idom[i]];
+}
+
+// One reference per fanout, as the removal of a fanout releases it
+void
+CirMgr::buildMffcRefs()
+{
+   _mffcRef.assign(_totalList.size(), 0);
+   for(size_t i = 0, s = _totalList.size(); i < s; i++)
+      if(_totalList[i] != 0)
+         _mffcRef[i] = _totalList[i]->getFanout().size();
+}
+
+// Release the fanins of "g" and of every AIG left without references;
+// refMffc() restores the counts by walking the same gates
+unsigned
+CirMgr::derefMffc(const CirGate* g, GateList* cone)
+{
+   unsigned n = 0;
+   _mffcStack.clear();
+   _mffcStack.push_back(const_cast<CirGate*>(g));
+   while(!_mffcStack.empty()){
+      CirGate* h = _mffcStack.back();
+      _mffcStack.pop_back();
+      if(h->isAig()){
+         ++n;
+         if(cone) cone->push_back(h);
+      }
+      const vector<Pin>& fanin = h->getFanin();
+      for(size_t i = 0, s = fanin.size(); i < s; i++){
+         CirGate* p = fanin[i].getPin();
+         if(p->isAig() && --_mffcRef[p->getGateID()] == 0)
+            _mffcStack.push_back(p);
+      }
+   }
+   return n;
+}
+
+void
+CirMgr::refMffc(const CirGate* g)
+{
+   _mffcStack.clear();
+   _mffcStack.push_back(const_cast<CirGate*>(g));
+   while(!_mffcStack.empty()){
+      CirGate* h = _mffcStack.back();
+      _mffcStack.pop_back();
+      const vector<Pin>& fanin = h->getFanin();
+      for(size_t i = 0, s = fanin.size(); i < s; i++){
+         CirGate* p = fanin[i].getPin();
+         if(p->isAig() && _mffcRef[p->getGateID()]++ == 0)
+            _mffcStack.push_back(p);
+      }
+   }
+}
@@ -0,0 +1,257 @@
+/****************************************************************************
+  FileName     [ cirEqCache.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define persistent cache of equivalence results ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cirEqCache.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+#define EQ_CACHE_MAGIC     "CIREQC\0\0"
+#define EQ_CACHE_VERSION   1
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static bool
+entryLess(const CirEqCache::Key& k, uint64_t h0, uint64_t h1)
+{
+   return (k._h0 != h0)? (k._h0 < h0): (k._h1 < h1);
+}
+
+/*****************************************/
+/*   class CirEqCache member functions   */
+/*****************************************/
+bool
+CirEqCache::open(const string& fileName)
+{
+   close();
+   _fileName = fileName;
+   if(!mapFile()) { _fileName.clear(); return false; }
+   return true;
+}
+
+// Write the merged entries to a temporary file, which then replaces the
+// cache file, so that an interrupted save leaves the old cache intact
+bool
+CirEqCache::save()
+{
+   if(!isOpen()) return false;
+   if(_added.empty()) return true;
+   string tmpName = _fileName + ".tmp";
+   ofstream ofs(tmpName.c_str(), ios::binary | ios::trunc);
+   if(!ofs){
+      cerr << "Error: cannot write equivalence cache \"" << tmpName
+           << "\"!!" << endl;
+      return false;
+   }
+   const Entry* mapped = getEntries();
+   const uint32_t* mappedLits = getLits();
+   vector<Entry> entries;
+   vector<uint32_t> lits;
+   entries.reserve(_nMapped + _added.size());
+   size_t i = 0;
+   AddedMap::const_iterator it = _added.begin();
+   while(i < _nMapped || it != _added.end()){
+      bool takeAdded = (i == _nMapped) || (it != _added.end() &&
+         !(Key(mapped[i]._h0, mapped[i]._h1) < it->first));
+      Entry e;
+      if(takeAdded){
+         // a new result replaces the mapped one with the same key
+         if(i < _nMapped && it->first._h0 == mapped[i]._h0 &&
+            it->first._h1 == mapped[i]._h1) ++i;
+         e = it->second.first;
+         e._litBegin = lits.size();
+         lits.insert(lits.end(), it->second.second.begin(),
+                     it->second.second.end());
+         ++it;
+      }
+      else{
+         e = mapped[i];
+         e._litBegin = lits.size();
+         lits.insert(lits.end(), mappedLits + mapped[i]._litBegin,
+                     mappedLits + mapped[i]._litBegin + mapped[i]._nLits);
+         ++i;
+      }
+      entries.push_back(e);
+   }
+   Header h;
+   memcpy(h._magic, EQ_CACHE_MAGIC, sizeof(h._magic));
+   h._version = EQ_CACHE_VERSION;
+   h._entrySize = sizeof(Entry);
+   h._nEntries = entries.size();
+   h._nLits = lits.size();
+   ofs.write((const char*)&h, sizeof(h));
+   if(!entries.empty())
+      ofs.write((const char*)&entries[0], entries.size() * sizeof(Entry));
+   if(!lits.empty())
+      ofs.write((const char*)&lits[0], lits.size() * sizeof(uint32_t));
+   ofs.close();
+   if(!ofs || rename(tmpName.c_str(), _fileName.c_str()) != 0){
+      cerr << "Error: cannot write equivalence cache \"" << _fileName
+           << "\"!!" << endl;
+      remove(tmpName.c_str());
+      return false;
+   }
+   unmapFile();
+   _added.clear();
+   return mapFile();
+}
+
+void
+CirEqCache::close()
+{
+   unmapFile();
+   _added.clear();
+   _fileName.clear();
+}
+
+CirEqCache::Result
+CirEqCache::lookup(const Key& k, size_t nPis, vector<int>& cex,
+                   unsigned& conflicts) const
+{
+   const Entry* e = 0;
+   const uint32_t* lits = 0;
+   AddedMap::const_iterator it = _added.find(k);
+   if(it != _added.end()){
+      e = &it->second.first;
+      lits = it->second.second.empty()? 0: &it->second.second[0];
+   }
+   else if((e = findMapped(k)) != 0)
+      lits = getLits() + e->_litBegin;
+   if(e == 0) return EQ_UNKNOWN;
+   conflicts = e->_conflicts;
+   if(e->_result == EQ_DIFFERENT){
+      cex.assign(nPis, -1);
+      for(uint32_t j = 0; j < e->_nLits; j++)
+         if(lits[j] / 2 < nPis) cex[lits[j] / 2] = lits[j] & 1;
+   }
+   return Result(e->_result);
+}
+
+void
+CirEqCache::insert(const Key& k, Result r, const vector<int>& cex,
+                   unsigned conflicts)
+{
+   assert(r != EQ_UNKNOWN);
+   pair<Entry, vector<uint32_t> >& v = _added[k];
+   Entry& e = v.first;
+   e._h0 = k._h0; e._h1 = k._h1;
+   e._result = r;
+   e._conflicts = conflicts;
+   e._litBegin = 0;
+   e._reserved = 0;
+   v.second.clear();
+   if(r == EQ_DIFFERENT)
+      for(size_t i = 0, s = cex.size(); i < s; i++)
+         if(cex[i] >= 0) v.second.push_back(i * 2 + cex[i]);
+   e._nLits = v.second.size();
+}
+
+size_t
+CirEqCache::getNumEntries() const
+{
+   size_t n = _nMapped;
+   for(AddedMap::const_iterator it = _added.begin(); it != _added.end(); ++it)
+      if(findMapped(it->first) == 0) ++n;
+   return n;
+}
+
+//------------------------------------------------------------------------
+//   Private member functions
+//------------------------------------------------------------------------
+const CirEqCache::Entry*
+CirEqCache::getEntries() const
+{
+   return _map? (const Entry*)((const char*)_map + sizeof(Header)): 0;
+}
+
+const uint32_t*
+CirEqCache::getLits() const
+{
+   return _map? (const uint32_t*)(getEntries() + _nMapped): 0;
+}
+
+const CirEqCache::Entry*
+CirEqCache::findMapped(const Key& k) const
+{
+   const Entry* entries = getEntries();
+   size_t lo = 0, hi = _nMapped;
+   while(lo < hi){
+      size_t mid = (lo + hi) / 2;
+      if(entryLess(k, entries[mid]._h0, entries[mid]._h1)) hi = mid;
+      else if(entries[mid]._h0 == k._h0 && entries[mid]._h1 == k._h1)
+         return &entries[mid];
+      else lo = mid + 1;
+   }
+   return 0;
+}
+
+bool
+CirEqCache::mapFile()
+{
+   _fd = ::open(_fileName.c_str(), O_RDONLY);
+   if(_fd < 0 && errno == ENOENT)   // start an empty cache
+      _fd = ::open(_fileName.c_str(), O_RDONLY | O_CREAT, 0644);
+   struct stat st;
+   if(_fd < 0 || fstat(_fd, &st) != 0){
+      cerr << "Error: cannot open equivalence cache \"" << _fileName
+           << "\"!!" << endl;
+      unmapFile();
+      return false;
+   }
+   if(st.st_size == 0) { unmapFile(); return true; }
+   _mapSize = st.st_size;
+   _map = mmap(0, _mapSize, PROT_READ, MAP_SHARED, _fd, 0);
+   if(_map == MAP_FAILED) _map = 0;
+   const Header* h = (const Header*)_map;
+   if(_map == 0 || _mapSize < sizeof(Header) ||
+      memcmp(h->_magic, EQ_CACHE_MAGIC, sizeof(h->_magic)) != 0 ||
+      h->_version != EQ_CACHE_VERSION || h->_entrySize != sizeof(Entry) ||
+      _mapSize != sizeof(Header) + h->_nEntries * sizeof(Entry) +
+                  h->_nLits * sizeof(uint32_t)){
+      cerr << "Error: \"" << _fileName << "\" is not an equivalence cache!!"
+           << endl;
+      unmapFile();
+      return false;
+   }
+   _nMapped = h->_nEntries;
+   // findMapped() and save() rely on the entries being sorted
+   const Entry* entries = getEntries();
+   for(size_t i = 0; i < _nMapped; i++){
+      if((i == 0 || entryLess(Key(entries[i - 1]._h0, entries[i - 1]._h1),
+                              entries[i]._h0, entries[i]._h1)) &&
+         entries[i]._litBegin <= h->_nLits &&
+         entries[i]._nLits <= h->_nLits - entries[i]._litBegin) continue;
+      cerr << "Error: equivalence cache \"" << _fileName
+           << "\" is corrupted!!" << endl;
+      unmapFile();
+      return false;
+   }
+   return true;
+}
+
+void
+CirEqCache::unmapFile()
+{
+   if(_map) munmap(_map, _mapSize);
+   if(_fd >= 0) ::close(_fd);
+   _fd = -1; _map = 0; _mapSize = 0; _nMapped = 0;
+}
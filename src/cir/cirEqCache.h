@@ -0,0 +1,101 @@
+/****************************************************************************
+  FileName     [ cirEqCache.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define persistent cache of equivalence results ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_EQ_CACHE_H
+#define CIR_EQ_CACHE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <stdint.h>
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//   class CirEqCache
+//------------------------------------------------------------------------
+// Results of equivalence queries, keyed by a 128-bit structural hash of
+// the two cones (see CirMgr::fraig()). The file is mapped read-only when
+// opened; new results are kept in memory until save() rewrites the file.
+// File layout: a header, the entries sorted by key, and then the
+// counterexample literals (PI index * 2 + value) of all the entries.
+class CirEqCache
+{
+public:
+  enum Result
+  {
+    EQ_UNKNOWN    = 0,   // not in the cache
+    EQ_EQUIVALENT = 1,
+    EQ_DIFFERENT  = 2,   // with a counterexample
+    EQ_UNDECIDED  = 3    // with the conflict limit that was reached
+  };
+  struct Key
+  {
+    Key(uint64_t h0 = 0, uint64_t h1 = 0): _h0(h0), _h1(h1) {}
+    bool operator < (const Key& k) const
+      { return (_h0 != k._h0)? (_h0 < k._h0): (_h1 < k._h1); }
+    uint64_t  _h0;
+    uint64_t  _h1;
+  };
+
+  CirEqCache(): _fd(-1), _map(0), _mapSize(0), _nMapped(0) {}
+  ~CirEqCache() { close(); }
+
+  // An absent file is created empty; false if the file is not a cache
+  bool open(const string& fileName);
+  bool save();
+  void close();
+  bool isOpen() const { return !_fileName.empty(); }
+  const string& getFileName() const { return _fileName; }
+
+  // "cex" gets the value of each of "nPis" PIs (-1 if free) for
+  // EQ_DIFFERENT; "conflicts" gets the limit for EQ_UNDECIDED. Safe to
+  // call from several threads as long as nothing is inserted.
+  Result lookup(const Key&, size_t nPis, vector<int>& cex,
+                unsigned& conflicts) const;
+  void insert(const Key&, Result, const vector<int>& cex,
+              unsigned conflicts);
+
+  size_t getNumEntries() const;
+
+private:
+  struct Header
+  {
+    char      _magic[8];
+    uint32_t  _version;
+    uint32_t  _entrySize;
+    uint64_t  _nEntries;
+    uint64_t  _nLits;
+  };
+  struct Entry
+  {
+    uint64_t  _h0;
+    uint64_t  _h1;
+    uint32_t  _result;
+    uint32_t  _conflicts;
+    uint64_t  _litBegin;
+    uint32_t  _nLits;
+    uint32_t  _reserved;
+  };
+  typedef map<Key, pair<Entry, vector<uint32_t> > >  AddedMap;
+
+  string        _fileName;
+  int           _fd;
+  void*         _map;
+  size_t        _mapSize;
+  size_t        _nMapped;
+  AddedMap      _added;
+
+  const Entry* getEntries() const;
+  const uint32_t* getLits() const;
+  const Entry* findMapped(const Key&) const;
+  bool mapFile();
+  void unmapFile();
+};
+
+#endif // CIR_EQ_CACHE_H
@@ -0,0 +1,579 @@
+/****************************************************************************
+  FileName     [ cirFraig.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir FRAIG functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirStrash.h"
+#include "cirProver.h"
+#include "cirEqCache.h"
+#include "bdd.h"
+#include "util.h"
+#include "myTrace.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+#define FRAIG_WINDOW_PAIRS  256
+#define FRAIG_SOLVERS       4
+#define FRAIG_SOLVER_VARS   3000
+#define FRAIG_CHUNK_CEXS    8
+#define FRAIG_RETRY_SCALE   10
+#define FRAIG_MAX_RETRIES   2
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// Wall-clock time; CPU time would add up the time of all the workers
+typedef chrono::steady_clock  FraigClock;
+
+static double
+secondsSince(FraigClock::time_point start)
+{
+   return chrono::duration<double>(FraigClock::now() - start).count();
+}
+
+/****************************************/
+/*   class CirProver member functions   */
+/****************************************/
+Var
+CirProver::getVar(CirGate* root)
+{
+   if(_var[root->getGateID()] >= 0) return _var[root->getGateID()];
+   _stack.assign(1, root);
+   while(!_stack.empty()){
+      CirGate* g = _stack.back();
+      unsigned id = g->getGateID();
+      if(_var[id] >= 0) { _stack.pop_back(); continue; }
+      if(!g->isAig()){
+         // UNDEF is 0, as in simulation, so every counterexample replays
+         _var[id] = _solver.newVar();
+         if(g->getType() != PI_GATE) _solver.addClause(mkLit(_var[id], true));
+         _stack.pop_back();
+         continue;
+      }
+      const vector<Pin>& fanin = g->getFanin();
+      CirGate* a = fanin[0].getPin();
+      CirGate* b = fanin[1].getPin();
+      if(_var[a->getGateID()] < 0) { _stack.push_back(a); continue; }
+      if(_var[b->getGateID()] < 0) { _stack.push_back(b); continue; }
+      _var[id] = _solver.newVar();
+      _solver.addAigCNF(_var[id], _var[a->getGateID()], fanin[0].getInvPhase(),
+                        _var[b->getGateID()], fanin[1].getInvPhase());
+      _stack.pop_back();
+   }
+   return _var[root->getGateID()];
+}
+
+// Two calls: (a, b) = (1, 0) and then (0, 1), in the literals' phases
+int
+CirProver::prove(unsigned litA, unsigned litB, uint64_t maxConflicts)
+{
+   Var va = getVar(_total[litA / 2]), vb = getVar(_total[litB / 2]);
+   for(int val = 1; val >= 0; val--){
+      _solver.assumeRelease();
+      _solver.assumeProperty(va, bool(val) ^ (litA & 1));
+      _solver.assumeProperty(vb, !val ^ (litB & 1));
+      ++_nCalls;
+      int status = _solver.assumpSolveLimited(maxConflicts);
+      if(status != 0) return (status > 0)? 0: -1;
+   }
+   // later queries may use the equivalence without rediscovering it
+   _solver.addClause(mkLit(va, litA & 1), mkLit(vb, !(litB & 1)));
+   _solver.addClause(mkLit(va, !(litA & 1)), mkLit(vb, litB & 1));
+   return 1;
+}
+
+void
+CirProver::addMerge(unsigned repLit, unsigned lit)
+{
+   Var v = _var[lit / 2];
+   if(v < 0) return;
+   if(_var[repLit / 2] < 0 && !((repLit ^ lit) & 1))
+      { _var[repLit / 2] = v; return; }
+   Var r = getVar(_total[repLit / 2]);
+   _solver.addClause(mkLit(v, lit & 1), mkLit(r, !(repLit & 1)));
+   _solver.addClause(mkLit(v, !(lit & 1)), mkLit(r, repLit & 1));
+}
+
+/*******************************************/
+/*   Public member functions about fraig   */
+/*******************************************/
+// _dfsList is topologically ordered, so the fanins of a gate are final
+// (already merged) when the gate is visited; one pass is enough.
+void
+CirMgr::strash(bool verbose)
+{
+   TRACE_SPAN("strash");
+   StrashTable table(_aigList.size());
+   for(int i = 0, s = _dfsList.size(); i < s; i++){
+      CirGate* g = _dfsList[i];
+      if(!g->isAig()) continue;
+      const vector<Pin>& fanin = g->getFanin();
+      size_t key = StrashTable::getKey(fanin[0], fanin[1]);
+      CirGate* rep = table.insert(key, g);
+      if(rep != 0){
+         if(verbose)
+            cout << "Strashing: " << rep->getGateID() << " merging "
+                 << g->getGateID() << "...\n";
+         mergeGate(g, rep, false);
+      }
+   }
+   flushRemoved();
+}
+
+//------------------------------------------------------------------------
+//   Parallel proving
+//------------------------------------------------------------------------
+enum FraigResult
+{
+   FRAIG_UNTRIED   = 0,
+   FRAIG_PROVED    = 1,
+   FRAIG_REFUTED   = 2,
+   FRAIG_UNDECIDED = 3     // a call reached the conflict limit
+};
+
+// Is lit == repLit?
+struct FraigPair
+{
+   FraigPair(unsigned r, unsigned l, unsigned g)
+      : _repLit(r), _lit(l), _group(g), _chunk(0), _result(FRAIG_UNTRIED),
+        _solved(false), _cex(-1) {}
+   unsigned     _repLit;
+   unsigned     _lit;
+   unsigned     _group;    // index in _fecGrps
+   unsigned     _chunk;    // index in chunks
+   FraigResult  _result;
+   bool         _solved;   // by SAT in this round
+   int          _cex;      // index in the _cex of its chunk if refuted
+};
+
+// A unit of work: the FEC groups of the window are dealt to FRAIG_SOLVERS
+// chunks, a group going with its first pair to chunk k if that pair is in
+// the k-th run of the window. Chunk k is proved by solver k, which is kept
+// over the rounds and told of every merge, so that a cone is encoded once
+// per solver; a solver is only replaced once it has FRAIG_SOLVER_VARS
+// variables, as a satisfiable call assigns every one of them. A chunk
+// stops at FRAIG_CHUNK_CEXS refutations. What a solver is asked thus
+// depends on the rounds only, and the results do not depend on the worker
+// that takes a chunk or on the thread count (unless the time budget runs
+// out); threads beyond FRAIG_SOLVERS are idle.
+struct FraigChunk
+{
+   FraigChunk(unsigned s, size_t b)
+      : _solver(s), _begin(b), _end(b + 1), _nCalls(0), _nLookups(0),
+        _nHits(0) {}
+   unsigned              _solver;
+   size_t                _begin;
+   size_t                _end;
+   size_t                _nCalls;
+   size_t                _nLookups;   // in the equivalence cache
+   size_t                _nHits;
+   vector<vector<int> >  _cex;     // PI values per refutation, -1 if free
+};
+
+struct FraigOrderLess
+{
+   FraigOrderLess(const vector<unsigned>& o): _order(o) {}
+   bool operator() (const FraigPair& a, const FraigPair& b) const {
+      return _order[a._lit / 2] < _order[b._lit / 2];
+   }
+   const vector<unsigned>& _order;
+};
+
+struct FraigChunkLess
+{
+   bool operator() (const FraigPair& a, const FraigPair& b) const {
+      return a._chunk < b._chunk;
+   }
+};
+
+//------------------------------------------------------------------------
+//   Equivalence cache
+//------------------------------------------------------------------------
+typedef CirEqCache::Key  ConeHash;
+
+static inline uint64_t
+mix64(uint64_t x)
+{
+   x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+   x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+   return x ^ (x >> 31);
+}
+
+// Two independent 64-bit hashes of an ordered pair
+static inline ConeHash
+combine(const ConeHash& a, const ConeHash& b, uint64_t salt)
+{
+   uint64_t h1 = (a._h1 + 0x9E3779B97F4A7C15ULL) ^ mix64(b._h1 ^ ~salt);
+   return ConeHash(mix64(a._h0 ^ mix64(b._h0 + salt)), mix64(h1));
+}
+
+static inline ConeHash
+litHash(const ConeHash& h, bool inv)
+{
+   return inv? ConeHash(~h._h0, ~h._h1): h;
+}
+
+// A PI hashes its index in "piList" and an AIG the unordered pair of its
+// fanin literals, so that identical cones over the same PIs hash alike in
+// any circuit (and in any run). UNDEF gates are CONST0.
+static void
+hashCones(const GateList& dfsList, const GateList& piList, size_t nGates,
+          vector<ConeHash>& hash)
+{
+   TRACE_SPAN("hashCones");
+   hash.assign(nGates, ConeHash(mix64(0), mix64(~uint64_t(0))));
+   for(size_t i = 0, s = piList.size(); i < s; i++)
+      hash[piList[i]->getGateID()] = ConeHash(mix64(i + 1), mix64(~(i + 1)));
+   for(size_t i = 0, s = dfsList.size(); i < s; i++){
+      const CirGate* g = dfsList[i];
+      if(!g->isAig()) continue;
+      const Pin& a = g->getFanin()[0];
+      const Pin& b = g->getFanin()[1];
+      ConeHash ha = litHash(hash[a.getPin()->getGateID()], a.getInvPhase());
+      ConeHash hb = litHash(hash[b.getPin()->getGateID()], b.getInvPhase());
+      hash[g->getGateID()] = (hb < ha)? combine(hb, ha, 1): combine(ha, hb, 1);
+   }
+}
+
+// lit a == lit b iff !a == !b, so only the phase difference counts
+static ConeHash
+pairHash(const vector<ConeHash>& hash, const FraigPair& p)
+{
+   const ConeHash& ha = hash[p._repLit / 2];
+   const ConeHash& hb = hash[p._lit / 2];
+   bool inv = (p._repLit ^ p._lit) & 1;
+   return (hb < ha)? combine(hb, litHash(ha, inv), 2):
+                     combine(ha, litHash(hb, inv), 2);
+}
+
+// Decide the pairs whose gates both have BDDs, which are canonical; a
+// refutation leaves a pattern on which the two gates differ in "cexs"
+static void
+fraigByBdd(BddMgr& mgr, const vector<BddNode>& bdds, vector<FraigPair>& pairs,
+           vector<vector<int> >& cexs)
+{
+   TRACE_SPAN("fraigByBdd");
+   for(size_t i = 0, s = pairs.size(); i < s; i++){
+      FraigPair& p = pairs[i];
+      const BddNode& a = bdds[p._repLit / 2];
+      const BddNode& b = bdds[p._lit / 2];
+      if(a.isNull() || b.isNull()) continue;
+      bool inv = (p._repLit ^ p._lit) & 1;
+      if(a == (inv? ~b: b)) { p._result = FRAIG_PROVED; continue; }
+      BddNode diff = inv? ~(a ^ b): a ^ b;
+      if(diff.isNull()) continue;   // out of nodes; left to SAT
+      p._result = FRAIG_REFUTED;
+      cexs.push_back(vector<int>());
+      mgr.getSatPattern(diff, cexs.back());
+   }
+}
+
+// Take the result of "p" from "cache" instead of calling SAT, as if the
+// call were made. An undecided result only counts if its conflict limit
+// was at least "maxConflicts".
+static bool
+fraigByCache(const CirEqCache& cache, const vector<ConeHash>& hash,
+             size_t nPis, uint64_t maxConflicts, FraigPair& p,
+             FraigChunk& chunk)
+{
+   vector<int> cex;
+   unsigned conflicts = 0;
+   ++chunk._nLookups;
+   switch(cache.lookup(pairHash(hash, p), nPis, cex, conflicts)){
+      case CirEqCache::EQ_EQUIVALENT: p._result = FRAIG_PROVED; break;
+      case CirEqCache::EQ_DIFFERENT:
+         p._result = FRAIG_REFUTED;
+         p._cex = chunk._cex.size();
+         chunk._cex.push_back(cex);
+         break;
+      case CirEqCache::EQ_UNDECIDED:
+         if(conflicts < maxConflicts) return false;
+         p._result = FRAIG_UNDECIDED;
+         break;
+      default: return false;
+   }
+   ++chunk._nHits;
+   return true;
+}
+
+// Workers only read the AIG; each one writes to the chunks it takes.
+// Pairs are left untried once "deadline" (if any) has passed.
+static void
+fraigWorker(const GateList& piList, vector<FraigPair>& pairs,
+            vector<FraigChunk>& chunks, const vector<CirProver*>& provers,
+            atomic<size_t>& next, uint64_t maxConflicts,
+            const FraigClock::time_point* deadline, const CirEqCache* cache,
+            const vector<ConeHash>& hash)
+{
+   TRACE_SPAN("fraigWorker");
+   for(size_t c = next++; c < chunks.size(); c = next++){
+      FraigChunk& chunk = chunks[c];
+      CirProver& prover = *provers[chunk._solver];
+      size_t nCalls = prover.getNumCalls();
+      for(size_t i = chunk._begin; i < chunk._end; i++){
+         if(chunk._cex.size() == FRAIG_CHUNK_CEXS) break;
+         if(deadline && FraigClock::now() > *deadline) break;
+         FraigPair& p = pairs[i];
+         if(p._result != FRAIG_UNTRIED) continue;   // decided by BDD
+         if(cache && fraigByCache(*cache, hash, piList.size(), maxConflicts,
+                                  p, chunk))
+            continue;
+         int status = prover.prove(p._repLit, p._lit, maxConflicts);
+         p._solved = true;
+         if(status < 0) { p._result = FRAIG_UNDECIDED; continue; }
+         if(status > 0) { p._result = FRAIG_PROVED; continue; }
+         p._result = FRAIG_REFUTED;
+         p._cex = chunk._cex.size();
+         chunk._cex.push_back(vector<int>(piList.size()));
+         for(size_t k = 0, s = piList.size(); k < s; k++)
+            chunk._cex.back()[k] = prover.getPiValue(piList[k]);
+      }
+      chunk._nCalls = prover.getNumCalls() - nCalls;
+   }
+}
+
+// Each round pairs every member of a FEC group with the member that comes
+// first in _dfsList. The pairs of gates with BDDs (support of at most
+// _fraigBddSupport PIs) are decided first; of the others, the
+// FRAIG_WINDOW_PAIRS pairs that come first topologically are proved on
+// "nThreads" threads; the gates above the
+// window wait for the merges below them, which make their proofs easy.
+// The merges are then committed serially in topological order (followed by
+// strashing); a gate is only merged into an earlier one, so merging never
+// creates a cycle. The counterexamples, in chunk order, are simulated to
+// refine the groups. BDDs are built once: merging keeps the function of
+// every surviving gate. A SAT call is skipped if _eqCache (if any) has its
+// result, and the results of the calls made are added to it.
+// A SAT call stops at _fraigConflicts conflicts; the gate of an undecided
+// pair is queued for retry and skipped until no other pair is left. Then
+// the queue is revisited with FRAIG_RETRY_SCALE times the limit, up to
+// FRAIG_MAX_RETRIES times; what is still undecided stays unmerged. Once
+// _fraigSeconds (if nonzero) have passed, the remaining pairs are dropped.
+void
+CirMgr::fraig(unsigned nThreads, bool verbose)
+{
+   TRACE_SPAN("fraig");
+   FraigClock::time_point start = FraigClock::now();
+   FraigClock::time_point deadline = start + chrono::duration_cast
+      <FraigClock::duration>(chrono::duration<double>(_fraigSeconds));
+   const FraigClock::time_point* pDeadline = _fraigSeconds? &deadline: 0;
+   double simTime = 0, satTime = 0;
+   size_t nCalls = 0, nStrash = 0, nProofs = 0, nRefutes = 0, nResims = 0;
+   size_t nUndecided = 0, nRetries = 0, nBddProofs = 0, nBddRefutes = 0;
+   size_t nLookups = 0, nHits = 0, nAdded = 0;
+   uint64_t maxConflicts = _fraigConflicts? _fraigConflicts: SAT_NO_LIMIT;
+   vector<char> retry(_totalList.size(), 0);
+   bool timeout = false;
+   vector<unsigned> order(_totalList.size());
+   vector<FraigPair> pairs;
+   vector<FraigChunk> chunks;
+   vector<uint64_t> words(_piList.size());
+   size_t nAig = _aigList.size();
+   strash(false);
+   nStrash += nAig - _aigList.size();
+   BddMgr bddMgr(_piList.size());
+   vector<BddNode> bdds;
+   vector<vector<int> > bddCexs;
+   vector<ConeHash> hash;
+   vector<CirProver*> provers(FRAIG_SOLVERS, 0);
+   size_t nBdds = 0;
+   if(_fraigBddSupport > 0){
+      buildBdds(bddMgr, bdds, _fraigBddSupport);
+      for(size_t i = 0, s = _aigList.size(); i < s; i++)
+         if(!bdds[_aigList[i]->getGateID()].isNull()) ++nBdds;
+   }
+   while(!_fecGrps.empty() && !timeout){
+      TRACE_SPAN("fraig round");
+      FraigClock::time_point satStart = FraigClock::now();
+      for(size_t i = 0, s = _dfsList.size(); i < s; i++)
+         order[_dfsList[i]->getGateID()] = i + 1;
+      order[0] = 0;   // CONST0 leads its group even if it is in _dfsList
+      pairs.clear(); chunks.clear(); bddCexs.clear();
+      for(size_t i = 0, s = _fecGrps.size(); i < s; i++){
+         const IdList& grp = _fecGrps[i];
+         unsigned repLit = grp[0];
+         for(size_t j = 1, n = grp.size(); j < n; j++)
+            if(order[grp[j] / 2] < order[repLit / 2]) repLit = grp[j];
+         for(size_t j = 0, n = grp.size(); j < n; j++)
+            if(grp[j] != repLit && !retry[grp[j] / 2])
+               pairs.push_back(FraigPair(repLit, grp[j], i));
+      }
+      if(pairs.empty()){
+         // only queued pairs are left
+         if(nRetries == FRAIG_MAX_RETRIES) break;
+         ++nRetries;
+         if(maxConflicts != SAT_NO_LIMIT) maxConflicts *= FRAIG_RETRY_SCALE;
+         fill(retry.begin(), retry.end(), 0);
+         continue;
+      }
+      sort(pairs.begin(), pairs.end(), FraigOrderLess(order));
+      if(!bdds.empty()) fraigByBdd(bddMgr, bdds, pairs, bddCexs);
+      // keep the decided pairs and the first window of the others
+      size_t n = 0, nOpen = 0;
+      for(size_t i = 0, s = pairs.size(); i < s; i++){
+         if(pairs[i]._result == FRAIG_UNTRIED && ++nOpen > FRAIG_WINDOW_PAIRS)
+            continue;
+         if(pairs[i]._result == FRAIG_PROVED) ++nBddProofs;
+         else if(pairs[i]._result == FRAIG_REFUTED) ++nBddRefutes;
+         pairs[n++] = pairs[i];
+      }
+      pairs.erase(pairs.begin() + n, pairs.end());
+      vector<unsigned> chunkOf(_fecGrps.size(), FRAIG_SOLVERS);
+      for(size_t i = 0, s = pairs.size(); i < s; i++){
+         unsigned& c = chunkOf[pairs[i]._group];
+         if(c == FRAIG_SOLVERS) c = i * FRAIG_SOLVERS / s;
+         pairs[i]._chunk = c;
+      }
+      stable_sort(pairs.begin(), pairs.end(), FraigChunkLess());
+      for(size_t i = 0, s = pairs.size(); i < s; i++){
+         if(i > 0 && pairs[i]._chunk == chunks.back()._solver){
+            pairs[i]._chunk = chunks.size() - 1;
+            chunks.back()._end = i + 1;
+            continue;
+         }
+         CirProver*& prover = provers[pairs[i]._chunk];
+         if(prover && prover->getNumVars() > FRAIG_SOLVER_VARS)
+            { delete prover; prover = 0; }
+         if(!prover) prover = new CirProver(_totalList);
+         chunks.push_back(FraigChunk(pairs[i]._chunk, i));
+         pairs[i]._chunk = chunks.size() - 1;
+      }
+
+      if(_eqCache) hashCones(_dfsList, _piList, _totalList.size(), hash);
+      atomic<size_t> next(0);
+      vector<thread> workers;
+      for(unsigned t = 1; t < nThreads; t++)
+         workers.push_back(thread(fraigWorker, cref(_piList), ref(pairs),
+                                  ref(chunks), cref(provers), ref(next),
+                                  maxConflicts, pDeadline, _eqCache,
+                                  cref(hash)));
+      fraigWorker(_piList, pairs, chunks, provers, next, maxConflicts,
+                  pDeadline, _eqCache, hash);
+      for(size_t t = 0, s = workers.size(); t < s; t++) workers[t].join();
+      timeout = pDeadline && FraigClock::now() > deadline;
+
+      // commit phase, in topological order again
+      sort(pairs.begin(), pairs.end(), FraigOrderLess(order));
+      vector<const FraigPair*> proved;
+      for(size_t i = 0, s = pairs.size(); i < s; i++){
+         switch(pairs[i]._result){
+            case FRAIG_PROVED: proved.push_back(&pairs[i]); break;
+            case FRAIG_REFUTED: ++nRefutes; break;
+            case FRAIG_UNDECIDED:
+               ++nUndecided;
+               retry[pairs[i]._lit / 2] = 1;
+               break;
+            default: break;
+         }
+      }
+      for(size_t i = 0, s = chunks.size(); i < s; i++){
+         nCalls += chunks[i]._nCalls;
+         nLookups += chunks[i]._nLookups;
+         nHits += chunks[i]._nHits;
+      }
+      if(_eqCache){
+         static const vector<int> noCex;
+         for(size_t i = 0, s = pairs.size(); i < s; i++){
+            const FraigPair& p = pairs[i];
+            if(!p._solved) continue;
+            CirEqCache::Result r = CirEqCache::EQ_UNDECIDED;
+            if(p._result == FRAIG_PROVED) r = CirEqCache::EQ_EQUIVALENT;
+            else if(p._result == FRAIG_REFUTED) r = CirEqCache::EQ_DIFFERENT;
+            _eqCache->insert(pairHash(hash, p), r, (p._cex < 0)? noCex:
+                             chunks[p._chunk]._cex[p._cex],
+                             (unsigned)min(maxConflicts, uint64_t(~0u)));
+            ++nAdded;
+         }
+      }
+      for(size_t i = 0, s = proved.size(); i < s; i++){
+         CirGate* rep = _totalList[proved[i]->_repLit / 2];
+         CirGate* g = _totalList[proved[i]->_lit / 2];
+         bool inv = (proved[i]->_repLit ^ proved[i]->_lit) & 1;
+         if(verbose)
+            cout << "Fraig: " << rep->getGateID() << " merging "
+                 << (inv? "!": "") << g->getGateID() << "...\n";
+         mergeGate(g, rep, inv);
+         for(size_t k = 0; k < FRAIG_SOLVERS; k++)
+            if(provers[k])
+               provers[k]->addMerge(proved[i]->_repLit, proved[i]->_lit);
+      }
+      nProofs += proved.size();
+      if(!proved.empty()){
+         flushRemoved();   // merged gates leave _dfsList and the groups
+         nAig = _aigList.size();
+         strash(false);
+         nStrash += nAig - _aigList.size();
+      }
+      satTime += secondsSince(satStart);
+
+      FraigClock::time_point simStart = FraigClock::now();
+      vector<const vector<int>*> cexs;
+      for(size_t i = 0, s = bddCexs.size(); i < s; i++)
+         cexs.push_back(&bddCexs[i]);
+      for(size_t i = 0, s = chunks.size(); i < s; i++)
+         for(size_t j = 0, n = chunks[i]._cex.size(); j < n; j++)
+            cexs.push_back(&chunks[i]._cex[j]);
+      unsigned nCex = 0;
+      for(size_t i = 0, s = cexs.size(); i < s; i++){
+         const vector<int>& cex = *cexs[i];
+         if(nCex == 0)
+            for(size_t k = 0, t = words.size(); k < t; k++)
+               words[k] = simRandom();
+         uint64_t bit = uint64_t(1) << nCex;
+         for(size_t k = 0, t = words.size(); k < t; k++){
+            if(cex[k] < 0) continue;
+            words[k] = cex[k]? (words[k] | bit): (words[k] & ~bit);
+         }
+         if(++nCex < 64) continue;
+         simulate(words); refineFecGrps(~uint64_t(0)); ++nResims;
+         nCex = 0;
+      }
+      if(nCex > 0) { simulate(words); refineFecGrps(~uint64_t(0)); ++nResims; }
+      simTime += secondsSince(simStart);
+   }
+   for(size_t k = 0; k < FRAIG_SOLVERS; k++) delete provers[k];
+   if(!verbose) return;
+   cout << "Fraig: " << nCalls << " SAT call(s), " << nProofs
+        << " proof(s), " << nRefutes << " refutation(s), " << nUndecided
+        << " undecided, " << nStrash << " structural merge(s), " << nResims
+        << " resimulation(s), " << nThreads << " thread(s)" << endl;
+   if(!bdds.empty())
+      cout << "Fraig: " << nBdds << " AIG(s) with BDDs of support <= "
+           << _fraigBddSupport << ", " << nBddProofs << " proof(s) and "
+           << nBddRefutes << " refutation(s) by BDD" << endl;
+   if(_eqCache)
+      cout << "Fraig: equivalence cache hits " << nHits << " of " << nLookups
+           << " lookup(s) (" << fixed << setprecision(1)
+           << (nLookups? 100.0 * nHits / nLookups: 0.0) << "%), "
+           << nAdded << " new result(s)" << endl;
+   if(nRetries > 0 || timeout){
+      size_t nLeft = 0;
+      for(size_t i = 0, s = _fecGrps.size(); i < s; i++)
+         nLeft += _fecGrps[i].size() - 1;
+      cout << "Fraig: " << nRetries << " retry pass(es)";
+      if(timeout) cout << ", time budget of " << _fraigSeconds
+                       << " seconds exhausted";
+      cout << ", " << nLeft << " candidate pair(s) left unmerged" << endl;
+   }
+   cout << "Time: SAT sweep " << fixed << setprecision(4) << satTime
+        << ", simulation " << simTime << ", total " << secondsSince(start)
+        << " seconds" << endl;
+   cout.unsetf(ios::fixed);
+   cout << setprecision(6);
+}
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <stdarg.h>
 #include <cassert>
+#include <algorithm>
 #include "cirGate.h"
 #include "cirMgr.h"
 #include "util.h"
@@ -23,8 +24,8 @@ size_t CirGate::_globalRef = 0;
 // TODO: Implement memeber functions for class(es) in cirGate.h
 void printDivider();
 string getIdDate(const CirGate*, string);
-bool findMyInv(int, CirGate*);
-void printSpace(int);
+bool findMyInv(int, const CirGate*);
+void appendPin(string&, const CirGate*);
 
 
 /**************************************/
@@ -48,72 +49,99 @@ void
 CirGate::reportGate() const{ printGate(); }
 
 void
-CirGate::reportFanin(int level) const
-{  
+CirGate::reportFanin(int level) const { reportCone(level, true); }
+
+void
+CirGate::reportFanout(int level) const { reportCone(level, false); }
+
+void
+CirGate::reportFaninCount(int level) const { reportConeSize(level, true); }
+
+void
+CirGate::reportFanoutCount(int level) const { reportConeSize(level, false); }
+
+// The fanin (fanout) tree down to "level", walked with an explicit stack
+// and written to a single buffer. A gate is expanded the first time it is
+// reached above the last level; later visits print " (*)" instead.
+void
+CirGate::reportCone(int level, bool fanin) const
+{
    assert (level >= 0);
-   int dist = level;
+   struct Frame { const CirGate* _gate; int _dist; size_t _next; };
+   vector<Frame> stack;
+   string buf;
    setGlobalRef();
-   if(this->getInvPhase()) cout << "!";
-   this->faninTraversal(level, dist);
-}
-
-void 
-CirGate::faninTraversal(const int& level, int dist) const
-{
-   CirGate* next;
-   this->printPin();
-   dist--;
-   if(dist >= 0){
-      if(!this->isGlobalRef()){
-         this->setToGlobalRef();
-         cout << endl;
-         if(this->getFanin().size() != 0){   
-            for(int i = 0, s = _faninList.size(); i < s; i++){
-               next = _faninList[i].getPin();
-               printSpace(level - dist);
-               if(_faninList[i].getInvPhase() == true) cout << "!";
-               next->faninTraversal(level, dist);
-            }
-         }
-      }else{ (this->getFanin().size() != 0)? cout << " (*)" << endl : cout << endl; }
-   }else { cout << endl; }
+   if(this->getInvPhase()) buf += '!';
+   const CirGate* g = this;
+   int dist = level;
+   while(g != 0){
+      appendPin(buf, g);
+      const vector<Pin>& next = fanin? g->_faninList: g->_fanoutList;
+      if(--dist < 0) buf += '\n';
+      else if(g->isGlobalRef()) buf += next.empty()? "\n": " (*)\n";
+      else{
+         g->setToGlobalRef();
+         buf += '\n';
+         Frame f = { g, dist, 0 };
+         stack.push_back(f);
+      }
+      // the next unprinted child of the deepest expanded gate
+      g = 0;
+      while(!stack.empty() && g == 0){
+         Frame& f = stack.back();
+         const vector<Pin>& list = fanin? f._gate->_faninList:
+                                          f._gate->_fanoutList;
+         if(f._next == list.size()) { stack.pop_back(); continue; }
+         const Pin& p = list[f._next++];
+         buf.append(2 * (level - f._dist), ' ');
+         if(fanin? p.getInvPhase(): findMyInv(f._gate->getGateID(), p.getPin()))
+            buf += '!';
+         g = p.getPin();
+         dist = f._dist;
+      }
+   }
+   cout << buf << flush;
 }
 
+// Size and depth of the cone within "level", level by level, without
+// printing the tree
 void
-CirGate::reportFanout(int level) const
+CirGate::reportConeSize(int level, bool fanin) const
 {
    assert (level >= 0);
-   int dist = level;
+   vector<const CirGate*> frontier(1, this), reached;
+   size_t nGates = 0, nAigs = 0;
+   int depth = 0;
    setGlobalRef();
-   if(this->getInvPhase()) cout << "!";
-   this->fanoutTraversal(level, dist);
-}
-
-void 
-CirGate::fanoutTraversal(const int& level, int dist) const
-{
-   CirGate* prev;
-   this->printPin();
-   dist--;
-   if(dist >= 0){
-      if(!this->isGlobalRef()){
-         this->setToGlobalRef();
-         cout << endl;
-         if(this->getFanout().size() != 0){
-            for(int i = 0, s = _fanoutList.size(); i < s; i++){
-               prev = _fanoutList[i].getPin();
-               printSpace(level - dist);
-               if(findMyInv(this->getGateID(), prev) == true) cout << "!";
-               prev->fanoutTraversal(level, dist);
-            }
+   this->setToGlobalRef();
+   for(int d = 1; d <= level && !frontier.empty(); d++){
+      reached.clear();
+      for(size_t i = 0, s = frontier.size(); i < s; i++){
+         const vector<Pin>& list = fanin? frontier[i]->_faninList:
+                                          frontier[i]->_fanoutList;
+         for(size_t j = 0, n = list.size(); j < n; j++){
+            const CirGate* q = list[j].getPin();
+            if(q->isGlobalRef()) continue;
+            q->setToGlobalRef();
+            reached.push_back(q);
+            if(q->isAig()) ++nAigs;
          }
-      }else{ (this->getFanout().size() != 0)? cout << " (*)" << endl : cout << endl; }
-   }else{ cout << endl; }
+      }
+      if(reached.empty()) break;
+      nGates += reached.size();
+      depth = d;
+      frontier.swap(reached);
+   }
+   string buf;
+   appendPin(buf, this);
+   cout << (fanin? "Fanin": "Fanout") << " cone of " << buf << " within level "
+        << level << ": " << nGates << " gate(s) (" << nAigs << " AIG(s)), depth "
+        << depth << endl;
 }
 
-bool findMyInv(int ID, CirGate* prev)
+bool findMyInv(int ID, const CirGate* prev)
 {
-   vector<Pin> fanin = prev->getFanin();
+   const vector<Pin>& fanin = prev->getFanin();
    for(int i = 0, s = fanin.size(); i < s; i++){
       if(fanin[i].getPin()->getGateID() == ID) 
          return fanin[i].getInvPhase();
@@ -121,10 +149,11 @@ bool findMyInv(int ID, CirGate* prev)
    return false;
 }
 
-void printSpace(int n)
-{  
-   for(int i = 0; i < n; i++)
-      cout << "  ";
+void appendPin(string& buf, const CirGate* g)
+{
+   buf += (g->getType() == CONST_GATE)? string("CONST"): g->getTypeStr();
+   buf += ' ';
+   buf += to_string(g->getGateID());
 }
 
 void CirPiGate::printPin() const{ cout << "PI " << this->getGateID(); }
@@ -186,17 +215,55 @@ string getIdDate(const CirGate* pin, string gateName)
    return output;
 }
 
+static bool
+fanoutIdLess(const Pin& a, const Pin& b)
+{
+   return a.getPin()->getGateID() < b.getPin()->getGateID();
+}
+
 void
 CirGate::sortFanout()
 {
-   Pin temp;
+   stable_sort(_fanoutList.begin(), _fanoutList.end(), fanoutIdLess);
+}
+
+// replace the first fanin pin driven by "from" with "to"; "inv" is xor-ed
+// into the pin phase
+void
+CirGate::replaceFanin(CirGate* from, CirGate* to, bool inv)
+{
+   for(int i = 0, s = _faninList.size(); i < s; i++){
+      if(_faninList[i].getPin() == from){
+         _faninList[i] = Pin(to, _faninList[i].getInvPhase() ^ inv);
+         return;
+      }
+   }
+}
+
+// remove one fanout pin pointing to "to" (a gate may appear twice)
+void
+CirGate::removeFanout(CirGate* to)
+{
    for(int i = 0, s = _fanoutList.size(); i < s; i++){
-      for(int j = 0; j < i; j++){
-         if(_fanoutList[i].getPin()->getGateID() < _fanoutList[j].getPin()->getGateID()){
-            temp = _fanoutList[j];
-            _fanoutList[j] = _fanoutList[i];
-            _fanoutList[i] = temp;
-         }
+      if(_fanoutList[i].getPin() == to){
+         _fanoutList.erase(_fanoutList.begin() + i);
+         return;
       }
    }
 }
+
+void
+CirGate::removeFanoutIf(bool (*drop)(const CirGate*))
+{
+   size_t n = 0;
+   for(size_t i = 0, s = _fanoutList.size(); i < s; i++){
+      if(!drop(_fanoutList[i].getPin())) _fanoutList[n++] = _fanoutList[i];
+   }
+   _fanoutList.resize(n);
+}
+
+size_t
+Pin::getLit() const
+{
+   return size_t(_pin->getGateID()) * 2 + (_invPhase? 1: 0);
+}
@@ -30,6 +30,7 @@ public:
   ~Pin() {}
   CirGate* getPin() const { return _pin; }
   bool getInvPhase() const { return _invPhase; }
+  size_t getLit() const;
 
 private:
   CirGate* _pin;
@@ -51,16 +52,24 @@ public:
 
   // Basic access methods
   virtual string getTypeStr() const = 0;
+  virtual GateType getType() const = 0;
+  bool isAig() const { return getType() == AIG_GATE; }
   int getGateID() const { return _gateID; }
+  void setGateID(int id) { _gateID = id; }
   unsigned getLineNo() const { return _lineNO; }
   bool getInvPhase() const { return _invPhase; }
   string getSymbols() const { return _symbols; }
   void setSymbols(string s) { _symbols = s; }
 
-  vector<Pin> getFanin() const { return _faninList; }
-  vector<Pin> getFanout() const{ return _fanoutList; }
+  const vector<Pin>& getFanin() const { return _faninList; }
+  const vector<Pin>& getFanout() const{ return _fanoutList; }
   void setFanin(CirGate* ID, bool phase = false) { Pin inpin(ID, phase); _faninList.push_back(inpin); }
   void setFanout(CirGate* ID, bool phase = false) { Pin outpin(ID, phase); _fanoutList.push_back(outpin); }
+  void replaceFanin(CirGate*, CirGate*, bool);
+  void removeFanout(CirGate*);
+  void removeFanoutIf(bool (*)(const CirGate*));
+  void clearFanin() { _faninList.clear(); }
+  void clearFanIO() { _faninList.clear(); _fanoutList.clear(); }
 
   // Printing functions
   virtual void printGate() const = 0;
@@ -68,10 +77,13 @@ public:
   void reportGate() const;
   void reportFanin(int level) const;
   void reportFanout(int level) const;
-  void faninTraversal(const int& level, int dist) const;
-  void fanoutTraversal(const int& level, int dist) const;
+  void reportFaninCount(int level) const;
+  void reportFanoutCount(int level) const;
 
 private:
+  void reportCone(int level, bool fanin) const;
+  void reportConeSize(int level, bool fanin) const;
+
 protected:
   int _gateID;
   int _lineNO;
@@ -89,6 +101,7 @@ class CirPiGate: public CirGate
 public:
   CirPiGate(int ID = 0, int NO = 0): CirGate(ID, NO) {}
   string getTypeStr() const{ return "PI"; }
+  GateType getType() const{ return PI_GATE; }
   void printGate() const;
   void printPin() const;
 };
@@ -98,6 +111,7 @@ class CirPoGate: public CirGate
 public:
   CirPoGate(int ID = 0, int NO = 0): CirGate(ID, NO) {}
   string getTypeStr() const{ return "PO"; }
+  GateType getType() const{ return PO_GATE; }
   void printGate() const;
   void printPin() const;
 };
@@ -107,6 +121,7 @@ class AndGate: public CirGate
 public:
   AndGate(int ID = 0, int NO = 0): CirGate(ID, NO) {}
   string getTypeStr() const{ return "AIG"; }
+  GateType getType() const{ return AIG_GATE; }
   void printGate() const;
   void printPin() const;
 };
@@ -116,6 +131,7 @@ class UnDef: public CirGate
 public:
   UnDef(int ID = 0): CirGate(ID, 0) {}
   string getTypeStr() const{ return "UNDEF"; }
+  GateType getType() const{ return UNDEF_GATE; }
   void printGate() const;
   void printPin() const;
 };
@@ -125,6 +141,7 @@ class Const0: public CirGate
 public:
   Const0(): CirGate(0, 0) {}
   string getTypeStr() const{ return "CONST0"; }
+  GateType getType() const{ return CONST_GATE; }
   void printGate() const;
   void printPin() const;
 };
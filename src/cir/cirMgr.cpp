@@ -8,13 +8,16 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <cstdio>
 #include <ctype.h>
 #include <cassert>
 #include <cstring>
 #include "cirMgr.h"
 #include "cirGate.h"
+#include "cirStrash.h"
 #include "util.h"
+#include "myTrace.h"
 #include <stdlib.h>
 
 using namespace std;
@@ -150,6 +153,14 @@ parseError(CirParseError err)
 /*   class CirMgr member functions for circuit construction   */
 /**************************************************************/
 int myId2Num(int, bool);
+CirMgr::~CirMgr()
+{
+   for(int i = 0, s = _totalList.size(); i < s; i++)
+      delete _totalList[i];
+   for(int i = 0, s = _removedList.size(); i < s; i++)
+      delete _removedList[i];
+}
+
 void resetValue()
 {
    lineNo = 0;
@@ -160,45 +171,102 @@ void resetValue()
 }
 
 bool
-CirMgr::readCircuit(const string& fileName)
+CirMgr::readCircuit(const string& fileName, bool doStrash)
 {  
+   TRACE_SPAN("readCircuit");
    fstream inputfile;
    string part;
    vector<int> state; // M I L O A
-   vector<vector<int>> PoFanin, AIGFanin;
+   vector<int> PoFanin, AIGFanin; // flattened (ID, lit...) records
    inputfile.open(fileName);
    if(!inputfile) {
       cerr << "Cannot open design \"" << fileName << "\"!!" << endl;
       return false;
    }
    resetValue();
-   if(!readHeader(inputfile, state)) return false;
+   {
+      TRACE_SPAN("readHeader");
+      if(!readHeader(inputfile, state)) return false;
+   }
    _totalList.resize(state[0]+state[3]+1);
+   PoFanin.reserve(state[3] * 2);
+   AIGFanin.reserve(state[4] * 3);
    CirGate* const0 = new Const0();
    _totalList[0] = const0;
 
-   for(int i = 0; i < state[1]; i++){
-      if(!readInput(inputfile, state[0])) return false;
+   {
+      TRACE_SPAN("readInput");
+      for(int i = 0; i < state[1]; i++){
+         if(!readInput(inputfile, state[0])) return false;
+      }
    }
-   for(int i = 0; i < state[3]; i++){
-      if(!readOutput(inputfile, state[0], PoFanin)) return false;
+   {
+      TRACE_SPAN("readOutput");
+      for(int i = 0; i < state[3]; i++){
+         if(!readOutput(inputfile, state[0], PoFanin)) return false;
+      }
    }
-   for(int i = 0; i < state[4]; i++){
-      if(!readAig(inputfile, state[0], AIGFanin)) return false;
+   {
+      TRACE_SPAN("readAig");
+      for(int i = 0; i < state[4]; i++){
+         if(!readAig(inputfile, state[0], AIGFanin)) return false;
+      }
    }
-   setFanIO(PoFanin);
-   setFanIO(AIGFanin);
-   dfsTraversal(_poList);
-   sortFanout();
-
-   bool stopRun = false;
-   while(!stopRun){
-      if(!readSymbol(inputfile, stopRun)) return false;
+   if(doStrash){
+      // AIGs first so that PO fanins can be redirected to the survivors
+      bool stale = false;
+      StrashTable table(state[4]);
+      _litMap.resize(state[0] + 1);
+      for(int i = 0, s = _litMap.size(); i < s; i++) _litMap[i] = i * 2;
+      setFanIO(AIGFanin, 3, &table, stale);
+      setFanIO(PoFanin, 2, 0, stale);
+      clearList(_litMap);
+      flushRemoved();
+      if(stale) strash();
+   }else{
+      bool stale = false;
+      setFanIO(PoFanin, 2, 0, stale);
+      setFanIO(AIGFanin, 3, 0, stale);
+      buildDfsList();
+   }
+
+   {
+      TRACE_SPAN("readSymbol");
+      bool stopRun = false;
+      while(!stopRun){
+         if(!readSymbol(inputfile, stopRun)) return false;
+      }
    }
    while(readComment(inputfile)){}
+   buildSymbolIndex();
    return true;
 }
 
+CirGate*
+CirMgr::findGate(const string& token) const
+{
+   int gid;
+   if(myStr2Int(token, gid)) return (gid >= 0)? getGate(gid): 0;
+   unordered_map<string, CirGate*>::const_iterator it = _symbolIndex.find(token);
+   return (it != _symbolIndex.end())? it->second: 0;
+}
+
+// PIs and POs are never removed, so the index stays valid through
+// optimization and ID compaction
+void
+CirMgr::buildSymbolIndex()
+{
+   TRACE_SPAN("buildSymbolIndex");
+   _symbolIndex.clear();
+   _symbolIndex.reserve(_piList.size() + _poList.size());
+   for(int i = 0, s = _piList.size(); i < s; i++)
+      if(_piList[i]->getSymbols() != "")
+         _symbolIndex.insert(make_pair(_piList[i]->getSymbols(), _piList[i]));
+   for(int i = 0, s = _poList.size(); i < s; i++)
+      if(_poList[i]->getSymbols() != "")
+         _symbolIndex.insert(make_pair(_poList[i]->getSymbols(), _poList[i]));
+}
+
 bool
 CirMgr::readHeader(fstream& file, vector<int>& state)
 {
@@ -270,11 +338,9 @@ CirMgr::readInput(fstream& file, int& M)
       colNo = 0; errMsg = "PI"; errInt = num;
       return parseError(CANNOT_INVERTED);
    }
-   for(int i = 0, s = _piList.size(); i < s; i++){
-      if(num/2 == _piList[i]->getGateID()){ 
-         errInt = num; errGate = _piList[i]; 
-         return parseError(REDEF_GATE); 
-      }
+   if(_totalList[num/2] != 0){ 
+      errInt = num; errGate = _totalList[num/2]; 
+      return parseError(REDEF_GATE); 
    }
    if(missNewLine) return parseError(MISSING_NEWLINE);
    CirGate* PI = new CirPiGate(num, ++lineNo);
@@ -284,13 +350,12 @@ CirMgr::readInput(fstream& file, int& M)
 }
 
 bool
-CirMgr::readOutput(fstream& file, int& M, vector<vector<int>>& fanin)
+CirMgr::readOutput(fstream& file, int& M, vector<int>& fanin)
 {
    bool missNewLine = false;
    int num, ID;
    string I;
    vector<string> sections;
-   vector<int> out;
    CirGate* PO;
    getline(file, I);
    if(I == "") { 
@@ -304,31 +369,23 @@ CirMgr::readOutput(fstream& file, int& M, vector<vector<int>>& fanin)
    if(_poList.empty()){ ID = (M + 1) * 2; }
    else{ ID = (_poList[_poList.size() - 1]->getGateID() + 1) * 2; }
 
-   for(int i = 0, s = fanin.size(); i < s; i++){
-      if(num == fanin[i][1]){ 
-         errInt = num; errGate = _totalList[fanin[i][0]]; 
-         return parseError(REDEF_GATE); 
-      }
-   }
    if(missNewLine) return parseError(MISSING_NEWLINE);
 
    PO = new CirPoGate(ID, ++lineNo);
    _poList.push_back(PO);
    _totalList[ID/2] = PO;
 
-   out.push_back(ID/2); out.push_back(num);
-   fanin.push_back(out);
+   fanin.push_back(ID/2); fanin.push_back(num);
    return true;
 }
 
 bool
-CirMgr::readAig(fstream& file, int& M, vector<vector<int>>& fanin)
+CirMgr::readAig(fstream& file, int& M, vector<int>& fanin)
 {
    bool missNewLine = false;
-   int num, ID2;
+   int num, ID2, gate[3];
    string I;
    vector<string> sections;
-   vector<int> gate; 
    getline(file, I);
    if(I == "") { 
       if(!file.eof()) { colNo = 0; errMsg = "AIG literal ID"; return parseError(MISSING_NUM); }
@@ -342,19 +399,12 @@ CirMgr::readAig(fstream& file, int& M, vector<vector<int>>& fanin)
    }else{ errMsg = sections[0]; return parseError(MISSING_NUM); }
    ID2 = num;
    if(ID2 == 0 || ID2 == 1){ colNo = 0; errInt = ID2; return parseError(REDEF_CONST); }
-   for(int i = 0, s = _piList.size(); i < s; i++){
-      if(ID2/2 == _piList[i]->getGateID()){ 
-         errInt = ID2; errGate = _piList[i]; 
-         return parseError(REDEF_GATE); 
-      }
+   // only PIs and AIGs are stored at IDs <= M by now
+   if(_totalList[ID2/2] != 0){ 
+      errInt = ID2; errGate = _totalList[ID2/2]; 
+      return parseError(REDEF_GATE); 
    }
-   for(int i = 0, s = _aigList.size(); i < s; i++){
-      if(ID2/2 == _aigList[i]->getGateID()){ 
-         errInt = ID2; errGate = _aigList[i]; 
-         return parseError(REDEF_GATE); 
-      }
-   }
-   gate.push_back(ID2/2);
+   gate[0] = ID2/2;
    string str_i = to_string(ID2/2);
    colNo = str_i.size();
    for(int i = 1; i < 3; i++){
@@ -364,14 +414,14 @@ CirMgr::readAig(fstream& file, int& M, vector<vector<int>>& fanin)
       }else{ errMsg = sections[i]; return parseError(MISSING_NUM); }
       str_i = to_string(num);
       colNo += (str_i.size());
-      gate.push_back(num);
+      gate[i] = num;
    }
    if(missNewLine) return parseError(MISSING_NEWLINE);
 
    CirGate* AIG = new AndGate(ID2, ++lineNo);
    _aigList.push_back(AIG);
    _totalList[ID2/2] = AIG;
-   fanin.push_back(gate);
+   fanin.insert(fanin.end(), gate, gate + 3);
    return true;
 }
 
@@ -396,7 +446,7 @@ CirMgr::readSymbol(fstream& file, bool& stopRun)
       if(I[0] == ' ') return parseError(EXTRA_SPACE);
       else if(I[0] == '\t') { errInt = 9; return parseError(ILLEGAL_WSPACE); }
       if(I[i] != ' ' && I[i] != '\t' && I[i] != '\0'){
-         if(!isalnum(I[i])){
+         if(!isprint(I[i])){
             errInt = stoi(to_string(I[i]));
             return parseError(ILLEGAL_SYMBOL_NAME);
          }
@@ -498,18 +548,42 @@ CirMgr::cutPiece(string& pharse, vector<string>& words, int wordNum, bool& missN
    return true;
 }
 
+// "fanin" holds records of "stride" ints: (gate ID, fanin literal...).
+// With "table" given, fanin literals are first redirected through _litMap
+// and each AIG is hashed right after its fanins are known; a duplicate is
+// merged before being wired. A fanin defined later in the file may still be
+// merged afterwards, leaving its fanouts hashed on a stale key ("stale").
 void
-CirMgr::setFanIO(vector<vector<int>>& fanin)
+CirMgr::setFanIO(vector<int>& fanin, int stride, StrashTable* table, bool& stale)
 {
+   TRACE_SPAN("setFanIO");
    int ID, inID;
    bool phase;
-   for(int i = 0, s = fanin.size(); i < s; i++){
-      ID = fanin[i][0];
-      for(int j = 1, insize = fanin[0].size(); j < insize; j++){
-         inID = fanin[i][j] / 2;
-         (fanin[i][j]%2 == 1)? phase = true : phase = false;
+   for(int i = 0, s = fanin.size(); i < s; i += stride){
+      ID = fanin[i];
+      if(!_litMap.empty()){
+         bool forward = false;
+         for(int j = 1; j < stride; j++){
+            fanin[i+j] = _litMap[fanin[i+j]/2] ^ (fanin[i+j]%2);
+            CirGate* in = _totalList[fanin[i+j]/2];
+            if(in != 0 && in->isAig() && in->getFanin().empty()) forward = true;
+         }
+         if(table != 0 && !forward){
+            size_t key = StrashTable::getKey(fanin[i+1], fanin[i+2]);
+            CirGate* rep = table->insert(key, _totalList[ID]);
+            if(rep != 0){
+               _litMap[ID] = rep->getGateID() * 2;
+               mergeGate(_totalList[ID], rep, false);
+               continue;
+            }
+         }
+         if(forward) stale = true;
+      }
+      for(int j = 1; j < stride; j++){
+         inID = fanin[i+j] / 2;
+         (fanin[i+j]%2 == 1)? phase = true : phase = false;
          if(_totalList[inID] == 0){
-            CirGate* Undef = new UnDef(fanin[i][j]);
+            CirGate* Undef = new UnDef(fanin[i+j]);
             _totalList[inID] = Undef;
          }
          _totalList[ID]->setFanin(_totalList[inID], phase); // set fanin
@@ -521,6 +595,7 @@ CirMgr::setFanIO(vector<vector<int>>& fanin)
 void
 CirMgr::dfsTraversal(const GateList& sinkList)
 {
+   TRACE_SPAN("dfsTraversal");
    CirGate::setGlobalRef();
    for(int i = 0, s = sinkList.size(); i < s; i++){
       sinkList[i]->dfsTraversal(_dfsList);
@@ -530,11 +605,124 @@ CirMgr::dfsTraversal(const GateList& sinkList)
 void
 CirMgr::sortFanout()
 {
+   TRACE_SPAN("sortFanout");
    for(int t = 0, tSize = _totalList.size(); t < tSize; t++){
       if(_totalList[t] != 0) _totalList[t]->sortFanout();
    }
 }
 
+// Redirect every fanout of "from" to "to" ("inv" is xor-ed into the
+// redirected pins) and detach "from" from the netlist. The gate is freed
+// in flushRemoved() so that callers may keep iterating over _dfsList.
+void
+CirMgr::mergeGate(CirGate* from, CirGate* to, bool inv)
+{
+   const vector<Pin>& fanout = from->getFanout();
+   for(int i = 0, s = fanout.size(); i < s; i++){
+      fanout[i].getPin()->replaceFanin(from, to, inv);
+      to->setFanout(fanout[i].getPin());
+   }
+   const vector<Pin>& fanin = from->getFanin();
+   for(int i = 0, s = fanin.size(); i < s; i++){
+      fanin[i].getPin()->removeFanout(from);
+   }
+   from->clearFanIO();
+   _totalList[from->getGateID()] = 0;
+   _removedList.push_back(from);
+}
+
+void
+CirMgr::buildDfsList()
+{
+   TRACE_SPAN("buildDfsList");
+   _dfsList.clear();
+   dfsTraversal(_poList);
+   sortFanout();
+   clearDominators();
+}
+
+void
+CirMgr::flushRemoved()
+{
+   TRACE_SPAN("flushRemoved");
+   size_t n = 0;
+   for(int i = 0, s = _aigList.size(); i < s; i++){
+      if(_totalList[_aigList[i]->getGateID()] == _aigList[i])
+         _aigList[n++] = _aigList[i];
+   }
+   _aigList.resize(n);
+   for(int i = 0, s = _removedList.size(); i < s; i++)
+      delete _removedList[i];
+   _removedList.clear();
+   buildDfsList();
+   updateFecGrps();
+}
+
+// A new AND gate of "a" and "b", on a freed ID if there is one; IDs past
+// the end of _totalList are given back by fillIdHoles()
+CirGate*
+CirMgr::addAig(const Pin& a, const Pin& b)
+{
+   unsigned id;
+   if(!_freeIds.empty()){
+      id = _freeIds.back(); _freeIds.pop_back();
+   }else{
+      id = _totalList.size();
+      _totalList.push_back(0);
+   }
+   CirGate* g = new AndGate(id * 2, 0);
+   _totalList[id] = g;
+   _aigList.push_back(g);
+   g->setFanin(a.getPin(), a.getInvPhase());
+   g->setFanin(b.getPin(), b.getInvPhase());
+   a.getPin()->setFanout(g);
+   b.getPin()->setFanout(g);
+   return g;
+}
+
+// Detach "g" if it has no fanout left, and so on toward the PIs; the IDs
+// go to _freeIds in the order the gates are removed, the gates to
+// _removedList
+void
+CirMgr::removeDead(CirGate* g)
+{
+   GateList stack(1, g);
+   while(!stack.empty()){
+      CirGate* c = stack.back(); stack.pop_back();
+      if(!c->isAig() || _totalList[c->getGateID()] != c ||
+         !c->getFanout().empty()) continue;
+      const vector<Pin>& fanin = c->getFanin();
+      for(int j = 0, s = fanin.size(); j < s; j++){
+         fanin[j].getPin()->removeFanout(c);
+         stack.push_back(fanin[j].getPin());
+      }
+      c->clearFanIO();
+      _totalList[c->getGateID()] = 0;
+      _freeIds.push_back(c->getGateID());
+      _removedList.push_back(c);
+   }
+}
+
+// Move the gates that got IDs from "origSize" on into the holes left by
+// removed ones, so that _totalList keeps its size
+void
+CirMgr::fillIdHoles(size_t origSize)
+{
+   vector<unsigned> holes;
+   for(size_t i = 0, s = _freeIds.size(); i < s; i++)
+      if(_freeIds[i] < origSize && _totalList[_freeIds[i]] == 0)
+         holes.push_back(_freeIds[i]);
+   for(size_t i = origSize, s = _totalList.size(); i < s; i++){
+      if(_totalList[i] == 0) continue;
+      assert(!holes.empty());
+      _totalList[i]->setGateID(holes.back());
+      _totalList[holes.back()] = _totalList[i];
+      holes.pop_back();
+   }
+   _totalList.resize(origSize);
+   _freeIds.clear();
+}
+
 /**********************************************************/
 /*   class CirMgr member functions for circuit printing   */
 /**********************************************************/
@@ -655,47 +843,161 @@ CirMgr::printFloatGates() const
    }   
 }
 
+// Written to one buffer first, as a large netlist makes many small writes
 void
 CirMgr::writeAag(ostream& outfile) const
 {
+   ostringstream oss;
    // header
    int M =  _totalList.size() - _poList.size() - 1, A = 0;
-   vector<Pin> fanin;
    for(int i = 0, s = _dfsList.size(); i < s; i++){
-      if(typeid(*_dfsList[i]) == typeid(AndGate)) A++;
+      if(_dfsList[i]->isAig()) A++;
    }
-   outfile << "aag " << M << " " << _piList.size() << " 0 " << _poList.size() << " " <<  A << endl;
+   oss << "aag " << M << " " << _piList.size() << " 0 " << _poList.size() << " " <<  A << '\n';
    // PI
    for(int i = 0, s = _piList.size(); i < s; i++){
-      outfile << myId2Num(_piList[i]->getGateID(), _piList[i]->getInvPhase()) << endl;
+      oss << myId2Num(_piList[i]->getGateID(), _piList[i]->getInvPhase()) << '\n';
    }
    // PO
    for(int i = 0, s = _poList.size(); i < s; i++){
-      outfile << myId2Num(_poList[i]->getFanin()[0].getPin()->getGateID(), _poList[i]->getFanin()[0].getInvPhase()) << endl;
+      oss << myId2Num(_poList[i]->getFanin()[0].getPin()->getGateID(), _poList[i]->getFanin()[0].getInvPhase()) << '\n';
    }
    // AIG
    for(int i = 0, s = _dfsList.size(); i < s; i++){
-      if(typeid(*_dfsList[i]) == typeid(AndGate)){
-         outfile << myId2Num(_dfsList[i]->getGateID(), _dfsList[i]->getInvPhase());
-         fanin = _dfsList[i]->getFanin();
+      if(_dfsList[i]->isAig()){
+         oss << myId2Num(_dfsList[i]->getGateID(), _dfsList[i]->getInvPhase());
+         const vector<Pin>& fanin = _dfsList[i]->getFanin();
          for(int j = 0, faninSize = fanin.size(); j < faninSize; j++){
-            outfile << " " << myId2Num(fanin[j].getPin()->getGateID(), fanin[j].getInvPhase());
-         } outfile << endl;
+            oss << " " << myId2Num(fanin[j].getPin()->getGateID(), fanin[j].getInvPhase());
+         } oss << '\n';
       }      
    }
-   // Symbols
+   // Symbols, by PI/PO position
    for(int i = 0, s = _piList.size(); i < s; i++){
       if(_piList[i]->getSymbols() != "")
-         outfile << "i" << _piList[i]->getGateID() << " " << _piList[i]->getSymbols() << endl;
+         oss << "i" << i << " " << _piList[i]->getSymbols() << '\n';
    }
    for(int i = 0, s = _poList.size(); i < s; i++){
       if(_poList[i]->getSymbols() != "")
-         outfile << "i" << _poList[i]->getGateID() << " " << _poList[i]->getSymbols() << endl;
+         oss << "o" << i << " " << _poList[i]->getSymbols() << '\n';
    }
    // Comment
    for(int i = 0, s = _commentList.size(); i < s; i++){
-      outfile << _commentList[i] << endl;
+      oss << _commentList[i] << '\n';
+   }
+   outfile << oss.str();
+   outfile.flush();
+}
+
+// A self-contained AAG of the transitive fanin of "roots", one PO per
+// root (a PO root stands for its fanin and keeps its name). The cone is
+// collected by one marked DFS; its PIs are numbered first, in their
+// original order, and then its AIGs in topological order. An UNDEF gate
+// in the cone has no known value and becomes an extra (unnamed) PI.
+void
+CirMgr::writeCone(ostream& outfile, const GateList& roots) const
+{
+   const unsigned unseen = unsigned(-1);
+   vector<unsigned> var(_totalList.size(), unseen);
+   GateList cone, undefs;
+   vector<pair<const CirGate*, size_t> > stack;
+   for(size_t r = 0, nr = roots.size(); r < nr; r++){
+      const CirGate* root = roots[r];
+      if(root->getType() == PO_GATE) root = root->getFanin()[0].getPin();
+      if(var[root->getGateID()] != unseen) continue;
+      var[root->getGateID()] = 0;
+      stack.push_back(make_pair(root, size_t(0)));
+      while(!stack.empty()){
+         const CirGate* g = stack.back().first;
+         size_t& next = stack.back().second;
+         const vector<Pin>& fanin = g->getFanin();
+         if(next < fanin.size()){
+            const CirGate* f = fanin[next++].getPin();
+            if(var[f->getGateID()] != unseen) continue;
+            var[f->getGateID()] = 0;
+            stack.push_back(make_pair(f, size_t(0)));
+            continue;
+         }
+         if(g->isAig()) cone.push_back(const_cast<CirGate*>(g));
+         else if(g->getType() == UNDEF_GATE)
+            undefs.push_back(const_cast<CirGate*>(g));
+         stack.pop_back();
+      }
+   }
+
+   GateList pis;
+   for(size_t i = 0, s = _piList.size(); i < s; i++)
+      if(var[_piList[i]->getGateID()] != unseen) pis.push_back(_piList[i]);
+   pis.insert(pis.end(), undefs.begin(), undefs.end());
+   unsigned M = 0;
+   for(size_t i = 0, s = pis.size(); i < s; i++) var[pis[i]->getGateID()] = ++M;
+   for(size_t i = 0, s = cone.size(); i < s; i++) var[cone[i]->getGateID()] = ++M;
+
+   ostringstream oss;
+   oss << "aag " << M << " " << pis.size() << " 0 " << roots.size() << " "
+       << cone.size() << '\n';
+   for(size_t i = 0, s = pis.size(); i < s; i++)
+      oss << var[pis[i]->getGateID()] * 2 << '\n';
+   for(size_t r = 0, nr = roots.size(); r < nr; r++){
+      if(roots[r]->getType() == PO_GATE){
+         const Pin& p = roots[r]->getFanin()[0];
+         oss << var[p.getPin()->getGateID()] * 2 + p.getInvPhase() << '\n';
+      }
+      else oss << var[roots[r]->getGateID()] * 2 << '\n';
+   }
+   for(size_t i = 0, s = cone.size(); i < s; i++){
+      const vector<Pin>& fanin = cone[i]->getFanin();
+      oss << var[cone[i]->getGateID()] * 2;
+      for(size_t j = 0, n = fanin.size(); j < n; j++)
+         oss << " " << var[fanin[j].getPin()->getGateID()] * 2 +
+                       fanin[j].getInvPhase();
+      oss << '\n';
+   }
+   for(size_t i = 0, s = pis.size(); i < s; i++)
+      if(pis[i]->getSymbols() != "")
+         oss << "i" << i << " " << pis[i]->getSymbols() << '\n';
+   for(size_t r = 0, nr = roots.size(); r < nr; r++)
+      if(roots[r]->getType() == PO_GATE && roots[r]->getSymbols() != "")
+         oss << "o" << r << " " << roots[r]->getSymbols() << '\n';
+   oss << "c\ncone of";
+   for(size_t r = 0, nr = roots.size(); r < nr; r++)
+      oss << " " << roots[r]->getTypeStr() << " " << roots[r]->getGateID();
+   oss << '\n';
+   outfile << oss.str();
+   outfile.flush();
+}
+
+// Tseitin CNF of the gates in _dfsList plus one clause asking for some PO
+// to be 1; DIMACS variable v+1 is gate v. Hence the CNF of a miter is
+// unsatisfiable iff the two circuits are equivalent.
+void
+CirMgr::writeCnf(ostream& outfile) const
+{
+   int A = 0;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) A++;
+   outfile << "c generated from " << _piList.size() << " PI(s), "
+           << _poList.size() << " PO(s) and " << A << " AIG(s)" << endl;
+   outfile << "p cnf " << _totalList.size() - _poList.size() << " "
+           << 3 * A + 2 << endl;
+   outfile << "-1 0" << endl;   // CONST0
+   for(int i = 0, s = _dfsList.size(); i < s; i++){
+      if(!_dfsList[i]->isAig()) continue;
+      int f = _dfsList[i]->getGateID() + 1;
+      const vector<Pin>& fanin = _dfsList[i]->getFanin();
+      int a = fanin[0].getPin()->getGateID() + 1;
+      int b = fanin[1].getPin()->getGateID() + 1;
+      if(fanin[0].getInvPhase()) a = -a;
+      if(fanin[1].getInvPhase()) b = -b;
+      outfile << -f << " " << a << " 0\n" << -f << " " << b << " 0\n"
+              << f << " " << -a << " " << -b << " 0\n";
+   }
+   for(int i = 0, s = _poList.size(); i < s; i++){
+      const Pin& p = _poList[i]->getFanin()[0];
+      int o = p.getPin()->getGateID() + 1;
+      outfile << (p.getInvPhase()? -o: o) << " ";
    }
+   outfile << "0" << endl;
 }
 
 int myId2Num(int id, bool phase)
@@ -13,6 +13,8 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
+#include <stdint.h>
 
 using namespace std;
 
@@ -20,12 +22,24 @@ using namespace std;
 
 extern CirMgr *cirMgr;
 
+#define CIR_FRAIG_CONFLICTS   1000
+#define CIR_FRAIG_BDD_SUPPORT 12
+#define CIR_RESUB_LEAVES      8
+#define CIR_RESUB_MAX_LEAVES  10
+#define CIR_ACTIVITY_PATTERNS 65536
+#define CIR_ACTIVITY_BDD_SUPPORT 16
+
 // TODO: Define your own data members and member functions
 class CirMgr
 {
+  friend class CirRewriter;
+  friend class CirResubber;
+
 public:
-  CirMgr(){}
-  ~CirMgr() {}
+  CirMgr(): _simLog(0), _simulated(false),
+            _fraigConflicts(CIR_FRAIG_CONFLICTS), _fraigSeconds(0),
+            _fraigBddSupport(CIR_FRAIG_BDD_SUPPORT), _eqCache(0) {}
+  ~CirMgr();
 
   // Access functions
   // return '0' if "gid" corresponds to an undefined gate.
@@ -34,9 +48,17 @@ public:
       return _totalList[gid];
     return 0;
   }
+  // a gate ID, or the symbolic name of a PI or PO (PIs first if a PI and
+  // a PO share a name); '0' if there is no such gate
+  CirGate* findGate(const string&) const;
+  size_t getNumPIs() const { return _piList.size(); }
+  size_t getNumPOs() const { return _poList.size(); }
+  size_t getNumAigs() const { return _aigList.size(); }
 
   // Member functions about circuit construction
-  bool readCircuit(const string&);
+  bool readCircuit(const string&, bool doStrash = false);
+  // rebuild the DFS list from the POs (the netlist edits do it themselves)
+  void buildDfsList();
 
   // Member functions about circuit reporting
   void printSummary() const;
@@ -45,6 +67,53 @@ public:
   void printPOs() const;
   void printFloatGates() const;
   void writeAag(ostream&) const;
+  // the transitive fanin of the given gates, renumbered densely
+  void writeCone(ostream&, const GateList&) const;
+  void writeCnf(ostream&) const;
+  void printCuts(unsigned k, unsigned p) const;
+  void printFECPairs() const;
+  void printSupport() const;
+  // unit delay unless a delay table is given (see cirDepth.cpp)
+  void printDepth(unsigned numPos, istream* delayTable = 0) const;
+  // "nPatterns" random patterns, or the sequence in "patternFile" (in the
+  // format of CIRSIMulate -File); every PI and AIG also goes to "csv"
+  void printActivity(unsigned numGates,
+                     size_t nPatterns = CIR_ACTIVITY_PATTERNS,
+                     istream* patternFile = 0, ostream* csv = 0) const;
+
+  // Member functions about circuit optimization
+  void sweep(bool compact = false);
+  void optimize();
+  void strash(bool verbose = true);
+  void rewrite();
+  void balance();
+  // windows of at most "nLeaves" leaves (2 to CIR_RESUB_MAX_LEAVES)
+  void resub(unsigned nLeaves = CIR_RESUB_LEAVES, unsigned nThreads = 1);
+
+  // Member functions about simulation and fraig
+  void randomSim();
+  void fileSim(ifstream&);
+  void setSimLog(ofstream *logFile) { _simLog = logFile; }
+  // conflicts per SAT call (0: no limit) and wall-clock seconds (0: none)
+  void setFraigBudget(unsigned conflicts, unsigned seconds)
+    { _fraigConflicts = conflicts; _fraigSeconds = seconds; }
+  // pairs of gates with at most "maxSupport" PIs are decided by BDDs (0: off)
+  void setFraigBdd(unsigned maxSupport) { _fraigBddSupport = maxSupport; }
+  // results of earlier SAT calls (0: none); new results are added to it
+  void setEqCache(CirEqCache* cache) { _eqCache = cache; }
+  void fraig(unsigned nThreads = 1, bool verbose = true);
+
+  // Member functions about BDDs
+  void buildBdds(BddMgr&, vector<BddNode>&, unsigned maxSupport) const;
+
+  // Member functions about dominators and MFFCs (built on demand and
+  // dropped whenever the DFS list is rebuilt)
+  CirGate* getDominator(const CirGate*);
+  unsigned getMffcSize(const CirGate*, GateList* cone = 0);
+  void reportMffc(const CirGate*);
+
+  // Member functions about equivalence checking
+  void cec(const CirMgr&, bool byName, unsigned nThreads = 1) const;
 
 private:
   GateList _piList;
@@ -53,19 +122,64 @@ private:
   GateList _totalList;
   GateList _dfsList;
   vector<string> _commentList;
+  unordered_map<string, CirGate*> _symbolIndex;
   
   // funtions use in readCircuit
   bool readHeader(fstream&, vector<int>&);
   bool readInput(fstream&, int&);
-  bool readOutput(fstream&, int&, vector<vector<int>>&);
-  bool readAig(fstream&, int&, vector<vector<int>>&);
+  bool readOutput(fstream&, int&, vector<int>&);
+  bool readAig(fstream&, int&, vector<int>&);
   bool readSymbol(fstream&, bool&);
   bool readComment(fstream&);
+  void buildSymbolIndex();
   bool cutPiece(string&, vector<string>&, int, bool&);
-  void setFanIO(vector<vector<int>>&);
+  void setFanIO(vector<int>&, int, StrashTable*, bool&);
 
   void dfsTraversal(const GateList&);
   void sortFanout();
+
+  // funtions use in optimization
+  GateList _removedList;
+  vector<unsigned> _litMap; // var -> literal of its survivor (strash on read)
+  vector<unsigned> _freeIds;  // IDs of removed gates, reused by addAig()
+  void mergeGate(CirGate*, CirGate*, bool);
+  void flushRemoved();
+  void compactId();
+  CirGate* addAig(const Pin&, const Pin&);
+  void removeDead(CirGate*);
+  void fillIdHoles(size_t);
+
+  // funtions use in simulation and fraig
+  ofstream* _simLog;
+  bool _simulated;
+  vector<uint64_t> _simValue;  // 64 patterns per gate, indexed by ID
+  vector<IdList> _fecGrps;     // literals (ID * 2 + phase), sorted by ID
+  unsigned _fraigConflicts;
+  unsigned _fraigSeconds;
+  unsigned _fraigBddSupport;
+  CirEqCache* _eqCache;
+  static uint64_t simRandom();
+  void simulate(const vector<uint64_t>&);
+  void simulate(const uint64_t*, vector<uint64_t>&) const;
+  bool readPatterns(istream&, vector<uint64_t>&, size_t&) const;
+  bool refineFecGrps(uint64_t);
+  void updateFecGrps();
+  void clearFecGrps() { _fecGrps.clear(); _simulated = false; }
+  void writeSimLog(const vector<uint64_t>&, unsigned) const;
+
+  // funtions use in dominators and MFFCs
+  GateList _idom;              // immediate dominator, indexed by ID
+  vector<unsigned> _mffcRef;   // fanout references, indexed by ID
+  GateList _mffcStack;
+  void buildDominators();
+  void buildMffcRefs();
+  void clearDominators() { _idom.clear(); _mffcRef.clear(); }
+  unsigned derefMffc(const CirGate*, GateList*);
+  void refMffc(const CirGate*);
+
+  // funtions use in equivalence checking
+  void buildMiter(const CirMgr&, const CirMgr&, const vector<size_t>&,
+                  const vector<size_t>&);
 };
 
 #endif // CIR_MGR_H
@@ -0,0 +1,333 @@
+/****************************************************************************
+  FileName     [ cirNpn.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define 4-input NPN classification and AIG library ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include "cirNpn.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// One implementation per NPN class, ordered by the class representative.
+// Each one is the smallest AND/INV formula of the representative (found by
+// an exhaustive search over formula size), with identical sub-formulas
+// shared.
+const NpnImpl NpnLib::_lib[NPN_NUM_CLASS] = {
+   { 0x0000,  0,  0, {} },
+   { 0x0001,  3, 14, { 7, 9, 5,10, 3,12} },
+   { 0x0003,  2, 12, { 7, 9, 5,10} },
+   { 0x0006,  5, 18, { 2, 4, 3, 5,11,13, 9,14, 7,16} },
+   { 0x0007,  3, 14, { 2, 4, 9,11, 7,12} },
+   { 0x000F,  1, 10, { 7, 9} },
+   { 0x0016,  8, 24, { 2, 4, 5, 6, 3,12, 3, 5, 7,17,15,19,11,21, 9,22} },
+   { 0x0017,  5, 18, { 2, 4, 3, 5, 6,13,11,15, 9,16} },
+   { 0x0018,  6, 20, { 3, 4, 2, 6, 5, 7,13,15,11,16, 9,18} },
+   { 0x0019,  5, 18, { 3, 4, 4, 7, 2,13,11,15, 9,16} },
+   { 0x001B,  4, 16, { 3, 4, 2, 6,11,13, 9,14} },
+   { 0x001E,  6, 20, { 5, 6, 3,10, 3, 5, 7,15,13,17, 9,19} },
+   { 0x001F,  3, 14, { 3, 5, 6,11, 9,13} },
+   { 0x003C,  4, 16, { 4, 6, 5, 7,11,13, 9,14} },
+   { 0x003D,  5, 18, { 4, 6, 5, 7, 2,12,11,15, 9,16} },
+   { 0x003F,  2, 12, { 4, 6, 9,11} },
+   { 0x0069,  7, 22, { 4, 6, 5, 7,11,13, 2,14, 3,15,17,19, 9,21} },
+   { 0x006B,  8, 24, { 2, 5, 4, 6, 3,12, 3, 4, 7,17,15,19,11,20, 9,23} },
+   { 0x006F,  5, 18, { 2, 4, 3, 5,11,13, 6,15, 9,17} },
+   { 0x007E,  6, 20, { 3, 4, 2, 7, 5, 6,13,15,11,16, 9,19} },
+   { 0x007F,  3, 14, { 4, 6, 2,10, 9,13} },
+   { 0x00FF,  0,  9, {} },
+   { 0x0116, 10, 28, { 2, 4, 6, 8, 7, 9, 5,14, 3,16, 3, 5,15,21,19,23,13,24,
+                      11,26} },
+   { 0x0117,  7, 22, { 2, 4, 6, 8, 3, 5, 7, 9,15,17,13,19,11,20} },
+   { 0x0118,  9, 26, { 3, 4, 2, 6, 7, 8, 3,14, 5, 7, 9,19,17,21,13,23,11,24} },
+   { 0x0119,  7, 22, { 3, 4, 3, 7, 4, 7, 2,15, 9,17,13,19,11,21} },
+   { 0x011A,  8, 24, { 2, 6, 3, 7, 8,13, 7, 9, 5,17, 3,19,15,21,11,22} },
+   { 0x011B,  6, 20, { 3, 4, 2, 6, 3, 7, 8,15,13,17,11,18} },
+   { 0x011E,  8, 24, { 6, 8, 7, 9, 5,12, 3,14, 3, 5,13,19,17,21,11,22} },
+   { 0x011F,  5, 18, { 6, 8, 3, 5, 7, 9,13,15,11,17} },
+   { 0x012C,  8, 24, { 7, 9, 5,10, 2, 5, 6,15, 3, 5, 8,19,17,21,13,22} },
+   { 0x012D,  7, 22, { 2, 5, 6,11, 3, 5, 5, 7, 9,17,15,19,13,21} },
+   { 0x012F,  5, 18, { 2, 5, 6,11, 3, 5, 8,15,13,17} },
+   { 0x013C,  8, 24, { 4, 6, 7, 9, 5,12, 5, 7, 3,16, 8,19,15,21,11,22} },
+   { 0x013D,  6, 20, { 4, 6, 5, 7, 2,12, 8,13,15,17,11,18} },
+   { 0x013E,  9, 26, { 4, 6, 7, 8, 5,12, 3,14, 5, 7, 3,18, 9,21,17,23,11,25} },
+   { 0x013F,  5, 18, { 4, 6, 5, 7, 3,12, 8,15,11,17} },
+   { 0x0168,  9, 26, { 3, 5, 8,11, 2, 4, 9,15, 7,16,11,15, 6,21,19,23,13,24} },
+   { 0x0169,  8, 24, { 4, 6, 5, 7,11,13, 2,15, 3,11, 9,19,13,21,17,23} },
+   { 0x016A, 10, 28, { 2, 8, 2, 6, 9,13, 4,15, 4, 6, 7, 8,19,21, 3,22,17,25,
+                      11,26} },
+   { 0x016B,  8, 24, { 4, 6, 2,10, 5, 7, 3,14, 3,11, 9,19,17,21,13,23} },
+   { 0x016E,  9, 26, { 2, 8, 7, 8, 5,13, 3,14, 2, 6, 9,19, 4,21,17,23,11,24} },
+   { 0x016F,  6, 20, { 3, 5, 8,11, 2, 4,11,15, 6,17,13,19} },
+   { 0x017E, 10, 28, { 2, 8, 7, 8, 3,13, 5,15, 2, 6, 5, 7,19,21, 9,22,17,25,
+                      11,27} },
+   { 0x017F,  6, 20, { 4, 6, 2,10, 5, 7, 3,14, 8,17,13,19} },
+   { 0x0180,  7, 22, { 3, 4, 2, 7, 4, 9, 7, 8,15,17,13,19,11,20} },
+   { 0x0181,  6, 20, { 3, 4, 2, 7, 4, 9, 6,15,13,17,11,18} },
+   { 0x0182,  8, 24, { 2, 8, 3, 9, 5, 6, 2, 6, 4,17,15,19,13,20,11,22} },
+   { 0x0183,  6, 20, { 2, 8, 5, 6, 2, 6, 4,15,13,17,11,18} },
+   { 0x0186,  9, 26, { 3, 6, 2, 8, 3, 9, 7,15, 4,16, 5,17,19,21,13,22,11,24} },
+   { 0x0187,  8, 24, { 2, 8, 4, 6, 2,12, 3, 9, 4,17, 7,19,15,21,11,23} },
+   { 0x0189,  5, 18, { 3, 4, 3, 7, 4, 9,13,15,11,17} },
+   { 0x018B,  5, 18, { 3, 4, 2, 8, 5, 6,13,15,11,16} },
+   { 0x018F,  5, 18, { 2, 4, 6,11, 3, 5, 8,15,13,17} },
+   { 0x0196, 11, 30, { 2, 8, 4, 6, 5, 7,13,15, 9,17, 3,18, 2,13, 9,23,15,25,
+                      21,27,11,28} },
+   { 0x0197,  9, 26, { 2, 8, 5, 7, 4, 6, 2,14, 3,15,17,19, 9,21,13,23,11,25} },
+   { 0x0198,  8, 24, { 3, 4, 4, 9, 6, 8, 7, 9,15,17, 3,18,13,21,11,23} },
+   { 0x0199,  6, 20, { 3, 4, 2, 5, 3, 7, 8,15,13,17,11,18} },
+   { 0x019A,  9, 26, { 2, 8, 7, 9, 5,13, 3,15, 3, 9, 6,19, 5,20,17,23,11,24} },
+   { 0x019B,  7, 22, { 3, 4, 3, 7, 5, 6, 2,14, 9,17,13,19,11,21} },
+   { 0x019E, 11, 30, { 6, 8, 7, 9, 5,12, 3,14, 3, 5, 2, 4, 6,21, 9,23,19,25,
+                      17,27,11,28} },
+   { 0x019F,  7, 22, { 6, 8, 3, 5, 2, 4, 6,15, 9,17,13,19,11,21} },
+   { 0x01A8,  7, 22, { 2, 8, 5, 7, 2,13, 7, 8, 5,16,15,19,11,21} },
+   { 0x01A9,  5, 18, { 5, 7, 2,10, 2, 9,11,15,13,17} },
+   { 0x01AA,  5, 18, { 2, 8, 7, 8, 5,12, 3,15,11,17} },
+   { 0x01AB,  4, 16, { 2, 8, 5, 7, 3,13,11,15} },
+   { 0x01AC,  7, 22, { 3, 6, 5, 8, 3,12, 5, 7, 9,17,15,19,11,21} },
+   { 0x01AD,  6, 20, { 3, 6, 3, 5, 5, 7, 9,15,13,17,11,19} },
+   { 0x01AE,  6, 20, { 3, 5, 8,11, 5, 9, 7,15, 3,17,13,19} },
+   { 0x01AF,  4, 16, { 3, 6, 3, 5, 8,13,11,15} },
+   { 0x01BC,  9, 26, { 4, 8, 6, 9, 5,12, 3, 6, 3, 8, 5,19,17,21,15,23,11,25} },
+   { 0x01BD,  8, 24, { 4, 8, 2, 4, 2, 7, 5, 9, 6,17,15,19,13,21,11,23} },
+   { 0x01BE,  9, 26, { 4, 8, 5, 9, 7,13, 3,14, 5, 6, 3,19, 9,21,17,23,11,25} },
+   { 0x01BF,  6, 20, { 4, 8, 3, 7, 3, 4, 9,15,13,17,11,19} },
+   { 0x01E8,  9, 26, { 5, 6, 3,10, 5, 8, 3,14, 2, 4, 7,19, 9,21,17,23,13,25} },
+   { 0x01E9,  8, 24, { 5, 6, 3,10, 3, 5, 2, 4, 7,17, 9,19,15,21,13,23} },
+   { 0x01EA,  7, 22, { 3, 5, 8,11, 4, 6, 7, 8,15,17, 3,18,13,21} },
+   { 0x01EB,  6, 21, { 5, 7, 3,10, 4, 6, 3,15, 9,17,13,19} },
+   { 0x01EE,  6, 20, { 5, 9, 3,10, 5, 7, 3,14, 8,17,13,19} },
+   { 0x01EF,  5, 18, { 5, 6, 3,10, 3, 5, 8,15,13,17} },
+   { 0x01FE,  7, 23, { 7, 8, 5,10, 3,12, 5, 7, 3,16, 9,19,15,21} },
+   { 0x033C,  7, 22, { 4, 6, 7, 8, 5,12, 5, 7, 9,17,15,19,11,21} },
+   { 0x033D,  8, 24, { 4, 6, 7, 8, 5,12, 5, 7, 2,16, 9,19,15,21,11,23} },
+   { 0x033F,  4, 16, { 4, 6, 5, 7, 8,13,11,15} },
+   { 0x0356,  7, 22, { 7, 9, 5,10, 3,12, 3, 9, 5, 7,17,19,15,21} },
+   { 0x0357,  3, 15, { 3, 9, 5, 7,11,13} },
+   { 0x0358,  8, 24, { 2, 6, 7, 8, 5,12, 2, 4, 7,17, 9,19,15,21,11,23} },
+   { 0x0359,  8, 24, { 5, 9, 7,11, 2,13, 5, 7, 3, 7, 9,19,17,21,15,23} },
+   { 0x035A,  7, 22, { 2, 6, 7, 9, 3,12, 5, 7, 8,17,15,19,11,20} },
+   { 0x035B,  6, 20, { 2, 6, 5, 7, 3, 7, 9,15,13,17,11,19} },
+   { 0x035E,  8, 24, { 2, 6, 7, 8, 5,12, 5, 7, 3,16, 9,19,15,21,11,23} },
+   { 0x035F,  4, 16, { 2, 6, 5, 7, 8,13,11,15} },
+   { 0x0368, 11, 30, { 4, 8, 4, 6, 3,12, 5, 9, 6,17, 5, 7, 2,21, 9,23,19,25,
+                      15,27,11,29} },
+   { 0x0369,  9, 26, { 4, 6, 5, 7,11,13, 9,15, 2,16, 3,11, 9,21,13,23,19,25} },
+   { 0x036A,  9, 26, { 4, 8, 4, 6, 3,12, 3, 9, 5, 9, 6,19,17,21,15,23,11,25} },
+   { 0x036B,  7, 23, { 5, 7, 4, 6, 2,12, 3,13,15,17, 9,18,11,21} },
+   { 0x036C,  9, 26, { 4, 8, 2, 6, 9,13, 5,14, 2, 4, 9,19, 6,21,17,23,11,24} },
+   { 0x036D, 10, 28, { 4, 6, 2,10, 2, 9, 7,15, 5,16, 2, 6, 5,21, 9,23,19,25,
+                      13,27} },
+   { 0x036E,  8, 24, { 4, 8, 3, 4, 3, 9, 5, 9, 6,17,15,19,13,21,11,23} },
+   { 0x036F,  7, 23, { 5, 7, 2, 4, 3, 5,13,15, 6,17, 9,19,11,21} },
+   { 0x037C,  8, 24, { 4, 8, 7, 9, 5,12, 2, 4, 9,17, 6,19,15,21,11,22} },
+   { 0x037D,  8, 24, { 4, 8, 5, 9, 7,13, 5, 6, 2,17, 9,19,15,21,11,23} },
+   { 0x037E,  9, 26, { 4, 8, 3, 4, 7, 9, 3,14, 5, 9, 6,19,17,21,13,23,11,25} },
+   { 0x03C0,  5, 18, { 5, 6, 4, 8, 7, 9,13,15,11,16} },
+   { 0x03C1,  6, 20, { 5, 6, 6, 9, 2, 9, 5,15,13,17,11,19} },
+   { 0x03C3,  4, 16, { 5, 6, 6, 9, 4,13,11,15} },
+   { 0x03C5,  6, 20, { 5, 6, 4, 8, 7, 9, 2,14,13,17,11,18} },
+   { 0x03C6,  7, 23, { 3, 9, 7,11, 5,12, 2, 7, 9,17, 4,18,15,21} },
+   { 0x03C7,  5, 18, { 5, 6, 2, 7, 9,13, 4,15,11,17} },
+   { 0x03CF,  3, 14, { 5, 6, 4, 8,11,13} },
+   { 0x03D4,  8, 25, { 7, 8, 5,10, 3, 4, 2, 5, 6,17,15,19, 9,21,13,23} },
+   { 0x03D5,  6, 21, { 7, 8, 5,10, 4, 6, 2,15, 9,17,13,19} },
+   { 0x03D6,  9, 26, { 7, 9, 5,10, 3,12, 5, 7, 4, 6, 2,19, 9,21,17,23,15,25} },
+   { 0x03D7,  5, 19, { 5, 7, 4, 6, 2,13, 9,15,11,17} },
+   { 0x03D8,  7, 23, { 7, 8, 5,10, 2, 4, 3, 6,15,17, 9,19,13,21} },
+   { 0x03D9,  7, 22, { 5, 9, 2,10, 5, 7, 3, 7, 9,17,15,19,13,21} },
+   { 0x03DB,  6, 21, { 5, 7, 2, 4, 3, 6,13,15, 9,17,11,19} },
+   { 0x03DC,  6, 21, { 7, 8, 5,10, 3, 6, 5,15, 9,17,13,19} },
+   { 0x03DD,  5, 18, { 5, 9, 2,10, 5, 7, 8,15,13,17} },
+   { 0x03DE,  7, 23, { 3, 9, 7,11, 5,12, 3, 6, 5,17, 9,19,15,21} },
+   { 0x03FC,  5, 19, { 7, 8, 5,10, 5, 7, 9,15,13,17} },
+   { 0x0660,  7, 22, { 2, 4, 3, 5, 6, 8, 7, 9,15,17,13,18,11,20} },
+   { 0x0661, 10, 28, { 2, 4, 6, 8, 7, 9, 5,14, 3,16, 3, 5,15,21,19,23,13,25,
+                      11,26} },
+   { 0x0662,  7, 22, { 2, 4, 6, 8, 7, 9, 4,15, 3,17,13,19,11,20} },
+   { 0x0663,  8, 24, { 6, 8, 7, 9, 4,13, 3,14, 3,13, 5,19,17,21,11,23} },
+   { 0x0666,  5, 18, { 2, 4, 3, 5, 6, 8,13,15,11,16} },
+   { 0x0667,  7, 22, { 2, 4, 6, 8, 7, 9, 5,15, 3,16,13,19,11,20} },
+   { 0x0669, 13, 34, { 6, 8, 2, 4, 3, 5,13,15, 9,16, 7,18, 3, 4, 2, 5, 7, 9,
+                      25,27,23,28,21,31,11,32} },
+   { 0x066B, 10, 28, { 6, 8, 2, 5, 7, 9, 4,14, 3,16, 3, 4,15,21,19,23,13,25,
+                      11,27} },
+   { 0x066F,  7, 22, { 6, 8, 3, 4, 2, 5, 7, 9,15,17,13,18,11,21} },
+   { 0x0672,  7, 22, { 2, 4, 6, 8, 4, 8, 7,15, 3,16,13,19,11,20} },
+   { 0x0673,  7, 22, { 7, 9, 3,11, 4,13, 3, 5, 7,17, 8,19,15,21} },
+   { 0x0676,  6, 20, { 2, 4, 6, 8, 5, 7, 3,14,13,17,11,18} },
+   { 0x0678, 11, 30, { 6, 8, 7, 9, 4,12, 2,14, 2, 4, 3, 5, 8,21, 7,23,19,25,
+                      17,27,11,29} },
+   { 0x0679, 11, 30, { 6, 8, 2, 4, 3, 5,13,15, 9,17, 7,18, 8,15, 7,23,13,25,
+                      21,27,11,29} },
+   { 0x067A,  9, 26, { 6, 8, 7, 9, 4,13, 2,14, 4, 8, 7,19, 3,20,17,23,11,24} },
+   { 0x067B,  9, 26, { 4, 8, 2,10, 3,11, 7,15, 3, 6, 4,19, 9,21,17,23,13,25} },
+   { 0x067E,  8, 24, { 6, 8, 3, 4, 3, 7, 7, 9, 4,17,15,19,13,21,11,23} },
+   { 0x0690, 11, 30, { 6, 8, 4, 6, 5, 8,13,15, 2,16, 5, 6, 4, 8,21,23, 3,24,
+                      19,27,11,28} },
+   { 0x0691, 11, 30, { 6, 8, 4, 6, 5, 8,13,15, 2,16, 4, 8, 5, 9,21,23, 3,24,
+                      19,27,11,28} },
+   { 0x0693, 10, 28, { 2, 6, 3, 8,11,13, 4,14, 3, 5, 7,19, 2, 5, 9,23,21,25,
+                      17,27} },
+   { 0x0696, 10, 28, { 2, 4, 3, 5,11,13, 6,14, 3, 4, 2, 5, 6, 9,21,23,19,24,
+                      17,27} },
+   { 0x0697,  9, 26, { 4, 7, 2,10, 3, 5, 7,15, 2, 4,15,19, 9,21,17,23,13,25} },
+   { 0x069F,  9, 27, { 4, 6, 5, 8,11,13, 3,14, 5, 6, 4, 8,19,21, 2,22,17,25} },
+   { 0x06B0,  9, 26, { 6, 8, 3, 4, 6,13, 2, 4, 3, 5,17,19, 8,20,15,23,11,25} },
+   { 0x06B1, 10, 28, { 6, 8, 5, 8, 7,13, 2,14, 4, 8, 5, 9,19,21, 3,22,17,25,
+                      11,26} },
+   { 0x06B2,  9, 26, { 6, 8, 2, 5, 4, 8, 3,14, 3, 4, 6,19,17,21,13,22,11,25} },
+   { 0x06B3,  8, 24, { 3, 5, 7,11, 8,13, 2, 6, 3, 8,17,19, 4,20,15,23} },
+   { 0x06B4,  9, 27, { 3, 4, 9,11, 6,12, 2, 4, 2, 8, 5,19,17,21, 7,22,15,25} },
+   { 0x06B5,  9, 26, { 5, 8, 7,11, 2,12, 3, 5, 7,17, 3, 4, 9,21,19,23,15,25} },
+   { 0x06B6,  8, 25, { 3, 4, 9,11, 6,12, 2, 4, 3, 5,17,19, 7,20,15,23} },
+   { 0x06B7,  8, 24, { 4, 7, 2,10, 3, 5, 7,15, 3, 4, 9,19,17,21,13,23} },
+   { 0x06B9, 11, 30, { 4, 8, 5, 9,11,13, 3,14, 5, 7, 9,19, 5, 8, 2,23, 7,25,
+                      21,27,17,29} },
+   { 0x06BD, 11, 30, { 4, 8, 2,10, 2, 8, 5,15, 7,17, 3, 4, 2, 7,21,23, 9,24,
+                      19,27,13,29} },
+   { 0x06F0,  7, 22, { 6, 8, 2, 4, 3, 5,13,15, 8,16, 7,19,11,21} },
+   { 0x06F1,  8, 24, { 3, 5, 9,11, 7,12, 2, 4,11,17, 7,18, 8,21,15,23} },
+   { 0x06F2,  7, 22, { 6, 8, 2, 4, 4, 8, 3,15,13,17, 7,19,11,21} },
+   { 0x06F6,  6, 20, { 6, 8, 2, 4, 3, 5,13,15, 7,17,11,19} },
+   { 0x06F9,  8, 25, { 2, 4, 3, 5,11,13, 8,14, 7,16, 7,14, 9,21,19,23} },
+   { 0x0776,  7, 22, { 2, 4, 6, 8, 7, 9, 5,14, 3,16,13,19,11,20} },
+   { 0x0778,  8, 24, { 6, 8, 7, 9, 4,12, 2,14, 2, 4,13,19,17,21,11,23} },
+   { 0x0779, 10, 28, { 6, 8, 3, 5, 7, 9, 4,14, 2,16, 2, 4,15,21,19,23,13,24,
+                      11,27} },
+   { 0x077A,  7, 22, { 6, 8, 7, 9, 2,12, 2, 4,13,17,15,19,11,21} },
+   { 0x077E,  8, 24, { 6, 8, 3, 4, 7, 9, 2,14, 5,15,17,19,13,20,11,23} },
+   { 0x07B0,  7, 22, { 6, 8, 3, 4, 6,13, 2, 4, 8,17,15,19,11,21} },
+   { 0x07B1,  8, 24, { 6, 8, 3, 5, 2, 6, 2, 4, 8,17,15,19,13,20,11,23} },
+   { 0x07B4,  8, 25, { 3, 4, 9,11, 6,12, 2, 4, 5, 9,17,19, 7,20,15,23} },
+   { 0x07B5,  7, 22, { 5, 8, 7,11, 2,12, 3, 4, 9,17, 6,19,15,21} },
+   { 0x07B6,  9, 26, { 4, 7, 2,10, 5, 9, 7,15, 5, 6, 3,19, 9,21,17,23,13,25} },
+   { 0x07BC,  8, 24, { 7, 9, 5,10, 2, 4, 7,15, 3, 4, 9,19,17,21,13,23} },
+   { 0x07E0,  7, 22, { 6, 8, 3, 5, 6,13, 2, 4, 8,17,15,19,11,21} },
+   { 0x07E1,  7, 23, { 3, 5, 9,11, 6,12, 2, 4,13,17, 7,18,15,21} },
+   { 0x07E2,  7, 22, { 6, 8, 2, 5, 3, 8, 4, 6,15,17,13,18,11,21} },
+   { 0x07E3,  7, 22, { 3, 8, 7,11, 4,12, 3, 5, 9,17, 6,19,15,21} },
+   { 0x07E6,  7, 22, { 6, 8, 3, 4, 3, 9, 4, 7,15,17,13,19,11,21} },
+   { 0x07E9, 11, 30, { 7, 9, 4,10, 3,12, 5, 8, 2,17, 7,19, 2, 6, 5,23, 9,25,
+                      21,27,15,29} },
+   { 0x07F0,  5, 18, { 6, 8, 2, 4, 8,13, 7,15,11,17} },
+   { 0x07F1,  7, 22, { 6, 8, 2, 4, 3, 5, 9,15,13,17, 7,19,11,21} },
+   { 0x07F2,  6, 20, { 6, 8, 2, 4, 3, 9,13,15, 7,17,11,19} },
+   { 0x07F8,  6, 21, { 2, 4, 8,11, 7,12, 7,11, 9,17,15,19} },
+   { 0x0FF0,  3, 14, { 6, 8, 7, 9,11,13} },
+   { 0x1668, 13, 35, { 6, 8, 5,10, 3,12, 3, 5, 7, 9, 4,18, 2,20, 2, 4,19,25,
+                      23,27,11,29,17,30,15,33} },
+   { 0x1669, 13, 34, { 2, 4, 3, 5, 6, 8, 7, 9,15,17,13,19,11,20, 3, 4, 3,15,
+                       5,27,17,29,25,30,23,33} },
+   { 0x166A, 10, 29, { 6, 8, 5,10, 3,12, 7, 9, 4,17, 2,18, 3,19,21,23,11,24,
+                      15,27} },
+   { 0x166B, 14, 37, { 3, 4, 7, 8, 3, 8, 6,15,13,17,11,18, 2, 4, 3, 5, 6, 8,
+                       7, 9,27,29,25,30,23,32,21,35} },
+   { 0x166E, 10, 29, { 6, 8, 5,10, 3,12, 3, 5, 7, 9, 4,19, 2,20,11,23,17,24,
+                      15,27} },
+   { 0x167E, 10, 29, { 5, 6, 3,10, 3, 5, 6, 8, 7, 9, 4,19, 2,20,17,23,15,24,
+                      13,27} },
+   { 0x1681, 14, 36, { 4, 6, 7, 8, 5,12,11,15, 3,17, 3, 8, 5, 6, 6, 9, 2, 9,
+                       5,27,25,29,23,31,21,33,19,35} },
+   { 0x1683, 12, 32, { 4, 6, 7, 8, 5,12,11,15, 3,17, 3, 8, 5, 6, 6, 9, 4,25,
+                      23,27,21,29,19,31} },
+   { 0x1686, 11, 30, { 4, 6, 3,10, 5, 7, 2,14, 6, 9, 2,19, 6, 8, 5,23,21,25,
+                      17,27,13,29} },
+   { 0x1687, 12, 32, { 4, 6, 3,10, 3, 8, 7,15, 5,16, 6, 9, 2,21, 6, 8, 5,25,
+                      23,27,19,29,13,31} },
+   { 0x1689, 12, 32, { 4, 8, 7, 8, 5,13,11,15, 3,16, 3, 7, 2, 6, 8,23, 5,25,
+                      11,27,21,29,19,31} },
+   { 0x168B, 12, 33, { 4, 9, 2,10, 4, 6, 7, 8, 5,16, 3,18, 3, 8, 5, 7,23,25,
+                      21,27,15,28,13,31} },
+   { 0x168E, 10, 28, { 4, 6, 3,10, 5, 7, 2,14, 2, 8, 6, 8, 5,21,19,23,17,25,
+                      13,27} },
+   { 0x1696, 10, 29, { 4, 6, 5, 7,11,13, 3,14, 5, 6, 6, 9, 4,21,19,23, 2,24,
+                      17,27} },
+   { 0x1697, 11, 31, { 4, 6, 7, 8, 5,12,11,15, 3,16, 5, 6, 6, 9, 4,23,21,25,
+                       2,26,19,29} },
+   { 0x1698, 11, 31, { 5, 6, 3,10, 3, 5, 4, 8, 2,16, 2, 4, 7, 8,21,23,19,25,
+                      15,26,13,29} },
+   { 0x1699, 10, 28, { 2, 4, 5, 7, 3,12,11,15, 8,17, 3, 5, 7, 8,21,23,11,24,
+                      19,27} },
+   { 0x169A, 10, 29, { 5, 6, 3,10, 4, 8, 3,15, 4, 9, 2, 4, 7,21,19,23,17,25,
+                      13,27} },
+   { 0x169B, 11, 30, { 7, 8, 4,11, 3,12, 5, 7, 3,17, 5, 6, 2, 5, 8,23,21,25,
+                      19,27,15,29} },
+   { 0x169E,  9, 27, { 4, 6, 5, 7,11,13, 3,14, 5, 6, 4, 8,19,21, 2,22,17,25} },
+   { 0x16A9, 13, 34, { 2, 8, 3, 9,11,13, 7,14, 5,16, 2, 9, 4, 6, 3, 8, 5, 7,
+                      25,27,23,29,21,31,19,33} },
+   { 0x16AC, 11, 31, { 7, 8, 5,10, 2,12, 2, 8, 4, 7, 5, 8, 3,21, 6,23,19,25,
+                      17,27,15,29} },
+   { 0x16AD, 13, 35, { 7, 8, 5,10, 2,12, 2, 8, 5, 8, 6,19, 3,20, 3, 9, 7,25,
+                       5,26,23,29,17,30,15,33} },
+   { 0x16BC, 10, 28, { 4, 6, 3,10, 7, 8, 5,14, 2,16, 2, 8, 5, 7,21,23,19,25,
+                      13,27} },
+   { 0x16E9, 14, 36, { 6, 8, 7, 9,11,13, 5,14, 3,16, 3, 5, 2, 4, 8,23, 7,24,
+                       7,23, 9,29,27,31,21,32,19,35} },
+   { 0x177E, 11, 31, { 5, 6, 3,10, 6, 8, 3, 4, 3, 9, 7, 9, 4,21,19,23,17,25,
+                      15,27,13,29} },
+   { 0x178E,  9, 26, { 4, 6, 3,10, 3, 8, 4, 8, 2, 7, 5,19,17,21,15,23,13,25} },
+   { 0x1796, 10, 28, { 4, 6, 5, 7,11,13, 2,14, 2, 9, 7, 9, 5,20,11,23,19,25,
+                      17,27} },
+   { 0x1798,  9, 27, { 5, 6, 3,10, 4, 8, 2,14, 2, 4, 7, 8,19,21,17,23,13,25} },
+   { 0x179A,  9, 26, { 5, 6, 2,10, 2, 9, 7, 9, 3, 7, 4,19,17,21,15,23,13,25} },
+   { 0x17AC,  9, 26, { 5, 7, 8,11, 2,12, 2, 6, 4, 6, 5, 9,19,21,17,23,15,25} },
+   { 0x17E8,  7, 23, { 2, 4, 3, 5, 6,13,11,15, 8,16, 9,17,19,21} },
+   { 0x18E7, 13, 34, { 4, 8, 3,10, 2, 6, 5, 7,15,17, 9,19, 7, 8, 2,23, 6, 8,
+                       5,27,25,29,21,31,13,33} },
+   { 0x19E1, 10, 29, { 7, 8, 4,10, 2,12, 6, 9, 5,16, 3,18, 3, 5,17,23,21,25,
+                      15,27} },
+   { 0x19E3, 11, 31, { 6, 9, 5,11, 3,12, 4, 7, 8,17, 4, 6, 4, 9, 2,23,21,25,
+                      19,27,15,29} },
+   { 0x19E6, 11, 31, { 4, 8, 5, 9,11,13, 3,14, 7, 8, 4,18, 4, 7, 9,23,21,25,
+                       2,27,17,29} },
+   { 0x1BD8,  9, 26, { 5, 6, 2,10, 5, 8, 6, 8, 2, 4, 7,19,17,21,15,23,13,25} },
+   { 0x1BE4,  9, 27, { 4, 8, 5, 9,11,13, 3,14, 6, 8, 7, 9,19,21, 2,22,17,25} },
+   { 0x1EE1,  8, 24, { 6, 8, 7, 9,11,13, 5,14, 3,16, 3, 5,15,21,19,23} },
+   { 0x3CC3,  6, 21, { 6, 8, 7, 9,11,13, 4,14, 5,15,17,19} },
+   { 0x6996, 12, 32, { 2, 4, 3, 5, 6, 8, 7, 9,15,17,13,18,11,20, 3, 4, 2, 5,
+                      19,27,25,28,23,31} },
+};
+
+/**************************************/
+/*   class NpnLib member functions    */
+/**************************************/
+// Expand every class representative through all 768 NPN transforms. This
+// is done once, at the first use of the library.
+NpnLib::NpnLib(): _classOf(1 << 16, NPN_NUM_CLASS), _trans(1 << 16, 0)
+{
+   unsigned char p[4] = { 0, 1, 2, 3 };
+   unsigned nPerm = 0;
+   do { copy(p, p + 4, _perm[nPerm++]); } while(next_permutation(p, p + 4));
+   for(unsigned c = 0; c < NPN_NUM_CLASS; c++){
+      for(unsigned i = 0; i < 24; i++)
+         for(unsigned n = 0; n < 16; n++)
+            for(unsigned o = 0; o < 2; o++){
+               uint16_t f = transform(_lib[c]._truth, _perm[i], n, o);
+               if(_classOf[f] != NPN_NUM_CLASS) continue;
+               _classOf[f] = c;
+               _trans[f] = (i << 5) | (n << 1) | o;
+            }
+   }
+}
+
+uint16_t
+NpnLib::transform(uint16_t g, const unsigned char* perm, unsigned neg,
+                  bool outNeg)
+{
+   uint16_t f = 0;
+   for(unsigned x = 0; x < 16; x++){
+      unsigned y = 0;
+      for(unsigned i = 0; i < 4; i++)
+         y |= (((x >> perm[i]) ^ (neg >> i)) & 1) << i;
+      if(((g >> y) & 1) ^ outNeg) f |= 1 << x;
+   }
+   return f;
+}
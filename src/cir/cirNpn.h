@@ -0,0 +1,60 @@
+/****************************************************************************
+  FileName     [ cirNpn.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define 4-input NPN classification and AIG library ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_NPN_H
+#define CIR_NPN_H
+
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+#define NPN_NUM_CLASS   222
+#define NPN_MAX_NODES   14
+
+//------------------------------------------------------------------------
+//   struct NpnImpl
+//------------------------------------------------------------------------
+// AIG of the canonical function of a class. Literals: 0/1 = const 0/1,
+// 2+2i(+1) = input i (inverted), 10+2k(+1) = node k (inverted).
+struct NpnImpl
+{
+  uint16_t       _truth;
+  unsigned char  _nNodes;
+  unsigned char  _out;
+  unsigned char  _fanin[NPN_MAX_NODES * 2];
+};
+
+//------------------------------------------------------------------------
+//   class NpnLib
+//------------------------------------------------------------------------
+// f(x) = o ^ canon(y), y_i = x_perm(i) ^ n_i. The transform of every
+// 4-input function is looked up in a 65536-entry table that is expanded
+// from the class representatives (the smallest truth table of each orbit).
+class NpnLib
+{
+public:
+  NpnLib();
+  ~NpnLib() {}
+
+  const NpnImpl& getImpl(uint16_t f) const { return _lib[_classOf[f]]; }
+  const unsigned char* getPerm(uint16_t f) const
+    { return _perm[_trans[f] >> 5]; }
+  unsigned getInputNeg(uint16_t f) const { return (_trans[f] >> 1) & 0xF; }
+  bool getOutputNeg(uint16_t f) const { return _trans[f] & 1; }
+
+  static uint16_t transform(uint16_t, const unsigned char*, unsigned, bool);
+
+private:
+  static const NpnImpl   _lib[NPN_NUM_CLASS];
+  unsigned char          _perm[24][4];
+  vector<unsigned char>  _classOf;   // function -> class index
+  vector<uint16_t>       _trans;     // (perm << 5) | (inNeg << 1) | outNeg
+};
+
+#endif // CIR_NPN_H
@@ -0,0 +1,105 @@
+/****************************************************************************
+  FileName     [ cirOpt.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir optimization functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// valid right after buildDfsList(): reachable gates carry the global ref
+static bool
+isSweepable(const CirGate* g)
+{
+   GateType t = g->getType();
+   return (t == AIG_GATE || t == UNDEF_GATE) && !g->isGlobalRef();
+}
+
+/**************************************************/
+/*   Public member functions about optimization   */
+/**************************************************/
+// Remove unused gates
+// DFS list should NOT be changed
+// UNDEF, float and unused list may be changed
+void
+CirMgr::sweep(bool compact)
+{
+   buildDfsList();
+   for(int i = 1, s = _totalList.size(); i < s; i++){
+      CirGate* g = _totalList[i];
+      if(g == 0 || !isSweepable(g)) continue;
+      cout << "Sweeping: " << g->getTypeStr() << "(" << g->getGateID()
+           << ") removed...\n";
+      _totalList[i] = 0;
+      _removedList.push_back(g);
+   }
+   // the fanouts of a removed gate are removed as well, so only the fanout
+   // lists of the survivors need to be filtered
+   for(int i = 0, s = _totalList.size(); i < s; i++){
+      CirGate* g = _totalList[i];
+      if(g == 0) continue;
+      g->removeFanoutIf(isSweepable);
+   }
+   for(int i = 0, s = _removedList.size(); i < s; i++)
+      _removedList[i]->clearFanIO();
+   flushRemoved();
+   if(compact) compactId();
+}
+
+// Fold AND gates with a constant or duplicated fanin. Fanins of a gate are
+// visited (and possibly replaced) before the gate itself, so one pass over
+// _dfsList propagates all rewrites; _dfsList is rebuilt afterwards.
+void
+CirMgr::optimize()
+{
+   CirGate* const0 = _totalList[0];
+   for(int i = 0, s = _dfsList.size(); i < s; i++){
+      CirGate* g = _dfsList[i];
+      if(!g->isAig()) continue;
+      const Pin& a = g->getFanin()[0];
+      const Pin& b = g->getFanin()[1];
+      Pin to;
+      if(a.getPin() == const0) to = a.getInvPhase()? b: a;        // AND(1,x), AND(0,x)
+      else if(b.getPin() == const0) to = b.getInvPhase()? a: b;   // AND(x,1), AND(x,0)
+      else if(a.getPin() == b.getPin())                             // AND(x,x), AND(x,!x)
+         to = (a.getInvPhase() == b.getInvPhase())? a: Pin(const0, false);
+      else continue;
+      cout << "Simplifying: " << to.getPin()->getGateID() << " merging "
+           << (to.getInvPhase()? "!": "") << g->getGateID() << "...\n";
+      mergeGate(g, to.getPin(), to.getInvPhase());
+   }
+   flushRemoved();
+}
+
+// Renumber variables densely: PIs, then AIGs, then UNDEFs, then POs
+void
+CirMgr::compactId()
+{
+   GateList newList(1, _totalList[0]);
+   for(int i = 0, s = _piList.size(); i < s; i++)
+      newList.push_back(_piList[i]);
+   for(int i = 0, s = _aigList.size(); i < s; i++)
+      newList.push_back(_aigList[i]);
+   for(int i = 1, s = _totalList.size(); i < s; i++)
+      if(_totalList[i] != 0 && _totalList[i]->getType() == UNDEF_GATE)
+         newList.push_back(_totalList[i]);
+   for(int i = 0, s = _poList.size(); i < s; i++)
+      newList.push_back(_poList[i]);
+   cout << "Compacting: " << _totalList.size() << " -> " << newList.size()
+        << " IDs\n";
+   for(int i = 0, s = newList.size(); i < s; i++)
+      newList[i]->setGateID(i);
+   _totalList.swap(newList);
+   sortFanout();
+   clearFecGrps();
+   clearDominators();
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+  FileName     [ cirProver.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define SAT-based equivalence prover over an AIG ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2012-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_PROVER_H
+#define CIR_PROVER_H
+
+#include <vector>
+#include "cirDef.h"
+#include "cirGate.h"
+#include "sat.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//   class CirProver
+//------------------------------------------------------------------------
+// An incremental solver over a read-only AIG. A gate is Tseitin-encoded
+// the first time a query reaches its cone.
+class CirProver
+{
+public:
+  CirProver(const GateList& totalList)
+    : _total(totalList), _var(totalList.size(), -1), _nCalls(0) {}
+
+  // Is gate(a) ^ phase(a) == gate(b) ^ phase(b)? 1 if proved; 0 if not,
+  // when getPiValue() gives the counterexample; -1 if a call reached
+  // "maxConflicts" conflicts.
+  int prove(unsigned litA, unsigned litB,
+            uint64_t maxConflicts = SAT_NO_LIMIT);
+  // "lit" has been merged into "repLit"; lets the gates encoded above
+  // "lit" see the equivalence
+  void addMerge(unsigned repLit, unsigned lit);
+  int getPiValue(const CirGate* pi) const
+    { return (_var[pi->getGateID()] < 0)? -1:
+             _solver.getValue(_var[pi->getGateID()]); }
+  size_t getNumCalls() const { return _nCalls; }
+  size_t getNumVars() const { return _solver.getNumVars(); }
+
+private:
+  const GateList&  _total;
+  SatSolver        _solver;
+  vector<Var>      _var;
+  GateList         _stack;
+  size_t           _nCalls;
+
+  Var getVar(CirGate*);
+};
+
+#endif // CIR_PROVER_H
@@ -0,0 +1,518 @@
+/****************************************************************************
+  FileName     [ cirResub.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define windowed resubstitution with existing divisors ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+#define RESUB_WINDOW_NODES  64    // max internal nodes of a window
+#define RESUB_MAX_DIVS      128   // max divisors of a window
+#define RESUB_MAX_PAIRS     4096  // max divisor pairs tried per node
+#define RESUB_CHUNK         256   // nodes evaluated between two commits
+#define RESUB_SIG_WORDS     2     // 64-bit random patterns per signature
+
+// Reports wall-clock time: clock() would sum the CPU time of all threads
+typedef chrono::steady_clock  ResubClock;
+
+//------------------------------------------------------------------------
+//   Resubstitution candidates and per-thread scratch
+//------------------------------------------------------------------------
+// "_node" is re-expressed as "_div[0]" (0-resub), or as the AND of
+// "_div[0]" and "_div[1]" (1-resub, one new gate), inverted if "_inv".
+// "_window" holds every gate the decision depends on.
+struct ResubCand
+{
+   ResubCand(CirGate* g = 0): _node(g), _gain(0), _nDivs(0), _inv(false) {}
+   CirGate*  _node;
+   int       _gain;
+   unsigned  _nDivs;
+   Pin       _div[2];
+   bool      _inv;
+   GateList  _window;
+};
+
+struct ResubScratch
+{
+   ResubScratch(): _curStamp(0), _nTt(0) {}
+   vector<unsigned>  _stamp;     // == _curStamp: in the current window
+   vector<unsigned>  _ttStamp;   // == _curStamp: "_local" is valid
+   vector<unsigned>  _local;     // ID -> index of the truth table
+   vector<unsigned>  _mffc;      // == _curStamp: "_ref" is valid
+   vector<int>       _ref;       // fanout references for the MFFC
+   unsigned          _curStamp;
+   vector<uint64_t>  _tt;
+   unsigned          _nTt;
+   GateList          _leaves;
+   GateList          _divs;
+   GateList          _stack;
+   vector<Pin>       _pos, _neg;   // literals implied by the node (or !node)
+
+   void resize(size_t n) {
+     if(_stamp.size() >= n) return;
+     _stamp.resize(n, 0); _ttStamp.resize(n, 0); _local.resize(n, 0);
+     _mffc.resize(n, 0); _ref.resize(n, 0);
+   }
+};
+
+//------------------------------------------------------------------------
+//   class CirResubber
+//------------------------------------------------------------------------
+// A window is grown from the fanins of a node toward the PIs, always
+// expanding the leaf that adds the fewest new leaves, until it has
+// "nLeaves" leaves; the gates above the window whose fanins are all in it
+// become extra divisors. Random simulation signatures rule out most
+// candidates, and the truth tables of the window over its leaves confirm
+// the rest exactly. Chunks of nodes are evaluated in parallel on the same
+// netlist and then committed in order; a candidate whose window meets one
+// committed before it in the chunk is evaluated again at its turn.
+class CirResubber
+{
+public:
+  CirResubber(CirMgr* mgr, unsigned nLeaves)
+    : _mgr(mgr), _total(mgr->_totalList), _origSize(mgr->_totalList.size()),
+      _nLeaves(nLeaves), _nWords(nLeaves > 6? 1 << (nLeaves - 6): 1),
+      _chunkStamp(0), _nResub0(0), _nResub1(0) {}
+
+  void run(unsigned nThreads);
+  size_t getNumResub0() const { return _nResub0; }
+  size_t getNumResub1() const { return _nResub1; }
+
+private:
+  CirMgr*           _mgr;
+  GateList&         _total;
+  size_t            _origSize;
+  unsigned          _nLeaves;
+  unsigned          _nWords;
+  vector<uint64_t>  _sig;        // RESUB_SIG_WORDS words per ID
+  vector<unsigned>  _committed;  // == _chunkStamp: touched in this chunk
+  unsigned          _chunkStamp;
+  size_t            _nResub0;
+  size_t            _nResub1;
+
+  bool isAlive(const CirGate* g) const
+    { return _total[g->getGateID()] == g; }
+  const uint64_t* sigOf(const CirGate* g) const
+    { return &_sig[g->getGateID() * RESUB_SIG_WORDS]; }
+  void setSig(CirGate*);
+
+  // evaluation (read-only on the netlist)
+  void evaluate(ResubCand&, ResubScratch&) const;
+  void buildWindow(CirGate*, ResubScratch&) const;
+  unsigned derefMffc(CirGate*, ResubScratch&) const;
+  uint64_t* ttOf(const CirGate* g, ResubScratch& s) const
+    { return &s._tt[s._local[g->getGateID()] * _nWords]; }
+  uint64_t* addTt(const CirGate*, ResubScratch&) const;
+  void setAndTt(const CirGate*, ResubScratch&) const;
+  bool sigImplies(const CirGate*, bool, const Pin&) const;
+  bool sigAndEquals(const CirGate*, bool, const Pin&, const Pin&) const;
+  bool ttImplies(const uint64_t*, bool, const Pin&, ResubScratch&) const;
+  bool ttAndEquals(const uint64_t*, bool, const Pin&, const Pin&,
+                   ResubScratch&) const;
+  void worker(vector<ResubCand>&, atomic<size_t>&, ResubScratch&) const;
+
+  // commit
+  bool isStale(const ResubCand&) const;
+  void commit(const ResubCand&);
+  CirGate* newAig(const Pin&, const Pin&);
+  void removeDead(CirGate*);
+};
+
+/*******************************************/
+/*   class CirResubber member functions    */
+/*******************************************/
+void
+CirResubber::run(unsigned nThreads)
+{
+   RandomWordGen wordGen;
+   _sig.assign(_total.size() * RESUB_SIG_WORDS, 0);
+   for(size_t i = 0, s = _mgr->_piList.size(); i < s; i++){
+      uint64_t* p = &_sig[_mgr->_piList[i]->getGateID() * RESUB_SIG_WORDS];
+      for(unsigned w = 0; w < RESUB_SIG_WORDS; w++) p[w] = wordGen();
+   }
+   for(size_t i = 0, s = _mgr->_dfsList.size(); i < s; i++)
+      if(_mgr->_dfsList[i]->isAig()) setSig(_mgr->_dfsList[i]);
+   _committed.assign(_total.size(), 0);
+
+   vector<ResubScratch> scratch(nThreads);
+   vector<ResubCand> chunk;
+   GateList order;
+   for(size_t i = 0, s = _mgr->_dfsList.size(); i < s; i++)
+      if(_mgr->_dfsList[i]->isAig()) order.push_back(_mgr->_dfsList[i]);
+   for(size_t next = 0; next < order.size(); ){
+      chunk.clear();
+      while(chunk.size() < RESUB_CHUNK && next < order.size())
+         chunk.push_back(ResubCand(order[next++]));
+      for(unsigned t = 0; t < nThreads; t++) scratch[t].resize(_total.size());
+
+      atomic<size_t> index(0);
+      vector<thread> workers;
+      for(unsigned t = 1; t < nThreads; t++)
+         workers.push_back(thread(&CirResubber::worker, this, ref(chunk),
+                                  ref(index), ref(scratch[t])));
+      worker(chunk, index, scratch[0]);
+      for(size_t t = 0, s = workers.size(); t < s; t++) workers[t].join();
+
+      // a candidate whose window was touched is evaluated again on the
+      // current netlist, as if the nodes were visited one by one
+      ++_chunkStamp;
+      for(size_t i = 0, s = chunk.size(); i < s; i++){
+         ResubCand& c = chunk[i];
+         if(c._gain <= 0 || !isAlive(c._node)) continue;
+         if(isStale(c)){
+            scratch[0].resize(_total.size());
+            evaluate(c, scratch[0]);
+            if(c._gain <= 0) continue;
+         }
+         commit(c);
+      }
+   }
+   _mgr->fillIdHoles(_origSize);
+}
+
+void
+CirResubber::setSig(CirGate* g)
+{
+   const Pin& a = g->getFanin()[0];
+   const Pin& b = g->getFanin()[1];
+   const uint64_t* sa = sigOf(a.getPin());
+   const uint64_t* sb = sigOf(b.getPin());
+   uint64_t* r = &_sig[g->getGateID() * RESUB_SIG_WORDS];
+   for(unsigned w = 0; w < RESUB_SIG_WORDS; w++)
+      r[w] = (a.getInvPhase()? ~sa[w]: sa[w]) & (b.getInvPhase()? ~sb[w]: sb[w]);
+}
+
+void
+CirResubber::worker(vector<ResubCand>& chunk, atomic<size_t>& index,
+                    ResubScratch& s) const
+{
+   for(size_t i; (i = index++) < chunk.size(); )
+      if(isAlive(chunk[i]._node)) evaluate(chunk[i], s);
+}
+
+// Leaves get the window stamp and the truth tables of their variables;
+// the internal nodes (but the node itself) follow them in "_divs" in
+// topological order
+void
+CirResubber::buildWindow(CirGate* g, ResubScratch& s) const
+{
+   ++s._curStamp;
+   s._leaves.clear();
+   s._stamp[g->getGateID()] = s._curStamp;
+   for(int j = 0; j < 2; j++){
+      CirGate* in = g->getFanin()[j].getPin();
+      if(s._stamp[in->getGateID()] != s._curStamp){
+         s._stamp[in->getGateID()] = s._curStamp;
+         s._leaves.push_back(in);
+      }
+   }
+   for(unsigned nInternal = 1; nInternal < RESUB_WINDOW_NODES; nInternal++){
+      int best = -1, bestCost = 3;
+      for(size_t i = 0, n = s._leaves.size(); i < n; i++){
+         const CirGate* l = s._leaves[i];
+         if(!l->isAig()) continue;
+         const CirGate* a = l->getFanin()[0].getPin();
+         const CirGate* b = l->getFanin()[1].getPin();
+         int cost = (s._stamp[a->getGateID()] != s._curStamp) +
+                    (b != a && s._stamp[b->getGateID()] != s._curStamp);
+         if(cost < bestCost) { bestCost = cost; best = i; }
+      }
+      if(best < 0 || s._leaves.size() - 1 + bestCost > _nLeaves) break;
+      CirGate* l = s._leaves[best];
+      s._leaves[best] = s._leaves.back();
+      s._leaves.pop_back();
+      for(int j = 0; j < 2; j++){
+         CirGate* in = l->getFanin()[j].getPin();
+         if(s._stamp[in->getGateID()] != s._curStamp){
+            s._stamp[in->getGateID()] = s._curStamp;
+            s._leaves.push_back(in);
+         }
+      }
+   }
+
+   static const uint64_t masks[6] = {
+      0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+      0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL };
+   s._nTt = 0;
+   s._divs.clear();
+   for(size_t i = 0, n = s._leaves.size(); i < n; i++){
+      uint64_t* t = addTt(s._leaves[i], s);
+      for(unsigned w = 0; w < _nWords; w++)
+         t[w] = (i < 6)? masks[i]: (((w >> (i - 6)) & 1)? ~uint64_t(0): 0);
+      s._divs.push_back(s._leaves[i]);
+   }
+   // every fanin of an internal node is a leaf or another internal node
+   GateList& todo = s._stack;
+   todo.clear();
+   todo.push_back(g);
+   while(!todo.empty()){
+      CirGate* c = todo.back();
+      if(s._ttStamp[c->getGateID()] == s._curStamp) { todo.pop_back(); continue; }
+      bool ready = true;
+      for(int j = 0; j < 2; j++){
+         CirGate* in = c->getFanin()[j].getPin();
+         if(s._ttStamp[in->getGateID()] != s._curStamp)
+            { ready = false; todo.push_back(in); }
+      }
+      if(!ready) continue;
+      todo.pop_back();
+      setAndTt(c, s);
+      if(c != g) s._divs.push_back(c);
+   }
+}
+
+uint64_t*
+CirResubber::addTt(const CirGate* g, ResubScratch& s) const
+{
+   s._ttStamp[g->getGateID()] = s._curStamp;
+   s._local[g->getGateID()] = s._nTt;
+   if((s._nTt + 1) * _nWords > s._tt.size())
+      s._tt.resize((s._nTt + 1) * _nWords * 2);
+   return &s._tt[s._nTt++ * _nWords];
+}
+
+void
+CirResubber::setAndTt(const CirGate* g, ResubScratch& s) const
+{
+   uint64_t* t = addTt(g, s);
+   const Pin& a = g->getFanin()[0];
+   const Pin& b = g->getFanin()[1];
+   const uint64_t* ta = ttOf(a.getPin(), s);
+   const uint64_t* tb = ttOf(b.getPin(), s);
+   for(unsigned w = 0; w < _nWords; w++)
+      t[w] = (a.getInvPhase()? ~ta[w]: ta[w]) & (b.getInvPhase()? ~tb[w]: tb[w]);
+}
+
+// Gates freed by removing "g", never past the leaves of its window; the
+// counts stay decremented so that divisors in the MFFC can be skipped
+unsigned
+CirResubber::derefMffc(CirGate* g, ResubScratch& s) const
+{
+   for(size_t i = 0, n = s._leaves.size(); i < n; i++){
+      unsigned id = s._leaves[i]->getGateID();
+      s._mffc[id] = s._curStamp;
+      s._ref[id] = RESUB_WINDOW_NODES * 2;   // never reaches 0
+   }
+   unsigned count = 0;
+   GateList& stack = s._stack;
+   stack.clear();
+   stack.push_back(g);
+   while(!stack.empty()){
+      CirGate* c = stack.back(); stack.pop_back();
+      ++count;
+      for(int j = 0; j < 2; j++){
+         CirGate* in = c->getFanin()[j].getPin();
+         unsigned id = in->getGateID();
+         if(s._mffc[id] != s._curStamp)
+            { s._mffc[id] = s._curStamp; s._ref[id] = in->getFanout().size(); }
+         if(--s._ref[id] == 0) stack.push_back(in);
+      }
+   }
+   return count;
+}
+
+bool
+CirResubber::sigImplies(const CirGate* g, bool inv, const Pin& p) const
+{
+   const uint64_t* sg = sigOf(g);
+   const uint64_t* sp = sigOf(p.getPin());
+   for(unsigned w = 0; w < RESUB_SIG_WORDS; w++)
+      if((inv? ~sg[w]: sg[w]) & ~(p.getInvPhase()? ~sp[w]: sp[w])) return false;
+   return true;
+}
+
+bool
+CirResubber::sigAndEquals(const CirGate* g, bool inv, const Pin& a,
+                          const Pin& b) const
+{
+   const uint64_t* sg = sigOf(g);
+   const uint64_t* sa = sigOf(a.getPin());
+   const uint64_t* sb = sigOf(b.getPin());
+   for(unsigned w = 0; w < RESUB_SIG_WORDS; w++)
+      if((inv? ~sg[w]: sg[w]) != ((a.getInvPhase()? ~sa[w]: sa[w]) &
+                                  (b.getInvPhase()? ~sb[w]: sb[w])))
+         return false;
+   return true;
+}
+
+bool
+CirResubber::ttImplies(const uint64_t* tg, bool inv, const Pin& p,
+                       ResubScratch& s) const
+{
+   const uint64_t* tp = ttOf(p.getPin(), s);
+   for(unsigned w = 0; w < _nWords; w++)
+      if((inv? ~tg[w]: tg[w]) & ~(p.getInvPhase()? ~tp[w]: tp[w])) return false;
+   return true;
+}
+
+bool
+CirResubber::ttAndEquals(const uint64_t* tg, bool inv, const Pin& a,
+                         const Pin& b, ResubScratch& s) const
+{
+   const uint64_t* ta = ttOf(a.getPin(), s);
+   const uint64_t* tb = ttOf(b.getPin(), s);
+   for(unsigned w = 0; w < _nWords; w++)
+      if((inv? ~tg[w]: tg[w]) != ((a.getInvPhase()? ~ta[w]: ta[w]) &
+                                  (b.getInvPhase()? ~tb[w]: tb[w])))
+         return false;
+   return true;
+}
+
+void
+CirResubber::evaluate(ResubCand& c, ResubScratch& s) const
+{
+   CirGate* g = c._node;
+   c._gain = 0;
+   buildWindow(g, s);
+   int mffc = derefMffc(g, s);
+
+   // the gates above the window whose fanins are all divisors
+   for(size_t i = 0; i < s._divs.size() &&
+                     s._divs.size() < RESUB_MAX_DIVS; i++){
+      const vector<Pin>& fanout = s._divs[i]->getFanout();
+      for(size_t j = 0, n = fanout.size(); j < n; j++){
+         CirGate* f = fanout[j].getPin();
+         if(!f->isAig() || s._stamp[f->getGateID()] == s._curStamp) continue;
+         const CirGate* a = f->getFanin()[0].getPin();
+         const CirGate* b = f->getFanin()[1].getPin();
+         if(a == g || b == g || s._stamp[a->getGateID()] != s._curStamp ||
+            s._stamp[b->getGateID()] != s._curStamp) continue;
+         s._stamp[f->getGateID()] = s._curStamp;
+         setAndTt(f, s);
+         s._divs.push_back(f);
+         if(s._divs.size() >= RESUB_MAX_DIVS) break;
+      }
+   }
+
+   const uint64_t* tg = ttOf(g, s);
+   s._pos.clear(); s._neg.clear();
+   for(size_t i = 0, n = s._divs.size(); i < n; i++){
+      CirGate* d = s._divs[i];
+      unsigned id = d->getGateID();
+      if(s._mffc[id] == s._curStamp && s._ref[id] == 0)
+         continue;   // dies with the node
+      for(int inv = 0; inv < 2; inv++){
+         Pin p(d, inv);
+         // p & p == p
+         if(sigAndEquals(g, false, p, p) && ttAndEquals(tg, false, p, p, s)){
+            c._gain = mffc; c._nDivs = 1; c._div[0] = p; c._inv = false;
+            break;
+         }
+         if(mffc < 2) continue;
+         if(sigImplies(g, false, p) && ttImplies(tg, false, p, s))
+            s._pos.push_back(p);
+         if(sigImplies(g, true, p) && ttImplies(tg, true, p, s))
+            s._neg.push_back(p);
+      }
+      if(c._gain > 0) break;
+   }
+   // g == a & b, or !g == a & b
+   for(int inv = 0; inv < 2 && c._gain == 0; inv++){
+      const vector<Pin>& lits = inv? s._neg: s._pos;
+      unsigned nPairs = 0;
+      for(size_t i = 0, n = lits.size(); i < n && c._gain == 0; i++)
+         for(size_t j = i + 1; j < n && nPairs++ < RESUB_MAX_PAIRS; j++){
+            if(lits[i].getPin() == lits[j].getPin()) continue;
+            if(!sigAndEquals(g, inv, lits[i], lits[j]) ||
+               !ttAndEquals(tg, inv, lits[i], lits[j], s)) continue;
+            c._gain = mffc - 1; c._nDivs = 2; c._inv = inv;
+            c._div[0] = lits[i]; c._div[1] = lits[j];
+            break;
+         }
+   }
+   if(c._gain <= 0) return;
+   c._window = s._divs;
+   c._window.push_back(g);
+}
+
+// The window was touched by a replacement earlier in the chunk
+bool
+CirResubber::isStale(const ResubCand& c) const
+{
+   for(size_t i = 0, s = c._window.size(); i < s; i++){
+      const CirGate* w = c._window[i];
+      if(!isAlive(w) || _committed[w->getGateID()] == _chunkStamp)
+         return true;
+   }
+   return false;
+}
+
+void
+CirResubber::commit(const ResubCand& c)
+{
+   CirGate* g = c._node;
+   Pin rep = c._div[0];
+   if(c._nDivs == 2) rep = Pin(newAig(c._div[0], c._div[1]), false);
+   if(c._inv) rep = Pin(rep.getPin(), !rep.getInvPhase());
+   GateList oldFanin;
+   for(int j = 0; j < 2; j++) oldFanin.push_back(g->getFanin()[j].getPin());
+   _mgr->_freeIds.push_back(g->getGateID());
+   _committed[g->getGateID()] = _chunkStamp;
+   _mgr->mergeGate(g, rep.getPin(), rep.getInvPhase());
+   for(int j = 0; j < 2; j++) removeDead(oldFanin[j]);
+   for(size_t i = 0, s = c._window.size(); i < s; i++)
+      if(isAlive(c._window[i]))
+         _committed[c._window[i]->getGateID()] = _chunkStamp;
+   if(c._nDivs == 2) ++_nResub1;
+   else ++_nResub0;
+}
+
+// CirMgr::addAig(), plus the signature of the new gate
+CirGate*
+CirResubber::newAig(const Pin& a, const Pin& b)
+{
+   CirGate* g = _mgr->addAig(a, b);
+   if(_committed.size() < _total.size()){
+      _committed.resize(_total.size(), 0);
+      _sig.resize(_total.size() * RESUB_SIG_WORDS, 0);
+   }
+   setSig(g);
+   _committed[g->getGateID()] = _chunkStamp;
+   return g;
+}
+
+// CirMgr::removeDead(), marking the removed gates as touched
+void
+CirResubber::removeDead(CirGate* g)
+{
+   size_t n = _mgr->_freeIds.size();
+   _mgr->removeDead(g);
+   for(size_t i = n, s = _mgr->_freeIds.size(); i < s; i++)
+      _committed[_mgr->_freeIds[i]] = _chunkStamp;
+}
+
+/**************************************************/
+/*   Public member functions about optimization   */
+/**************************************************/
+void
+CirMgr::resub(unsigned nLeaves, unsigned nThreads)
+{
+   assert(nLeaves >= 2 && nLeaves <= CIR_RESUB_MAX_LEAVES && nThreads > 0);
+   unsigned before = 0, after = 0;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++before;
+   ResubClock::time_point start = ResubClock::now();
+   CirResubber rsb(this, nLeaves);
+   rsb.run(nThreads);
+   flushRemoved();
+   clearFecGrps();   // IDs of removed gates may have been reused
+   double t = chrono::duration<double>(ResubClock::now() - start).count();
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++after;
+   cout << "Resub: " << rsb.getNumResub0() + rsb.getNumResub1()
+        << " replacement(s) (" << rsb.getNumResub0() << " by a divisor, "
+        << rsb.getNumResub1() << " by a new gate), AIG " << before << " -> "
+        << after << ", " << setprecision(4) << t << " seconds" << endl;
+}
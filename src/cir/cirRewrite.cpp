@@ -0,0 +1,289 @@
+/****************************************************************************
+  FileName     [ cirRewrite.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define DAG-aware AIG rewriting with 4-input NPN library ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "cirCut.h"
+#include "cirNpn.h"
+#include "cirStrash.h"
+#include "util.h"
+
+using namespace std;
+
+#define RWR_CONE_LIMIT  64   // max nodes visited to validate a cut
+
+//------------------------------------------------------------------------
+//   class CirRewriter
+//------------------------------------------------------------------------
+// Cuts are enumerated once on the original netlist. A cut is only used
+// while its leaves are the original gates and it still separates the node
+// from the PIs. Replaced gates are freed at the end of the pass (so that a
+// pointer never gets reused while comparing against the snapshot), and
+// their IDs are handed to the new gates.
+class CirRewriter
+{
+public:
+  CirRewriter(CirMgr* mgr): _mgr(mgr), _total(mgr->_totalList),
+     _snapshot(mgr->_totalList), _origSize(mgr->_totalList.size()),
+     _table(mgr->_aigList.size()), _stamp(_origSize, 0), _ref(_origSize, 0),
+     _curStamp(0), _nReplaced(0) {}
+
+  void run();
+  size_t getNumReplaced() const { return _nReplaced; }
+
+private:
+  CirMgr*           _mgr;
+  GateList&         _total;
+  GateList          _snapshot;
+  size_t            _origSize;
+  StrashTable       _table;
+  CirCutMgr         _cuts;
+  vector<unsigned>  _stamp;
+  vector<int>       _ref;
+  unsigned          _curStamp;
+  GateList          _stack;
+  size_t            _nReplaced;
+
+  bool isAlive(const CirGate* g) const
+    { return _total[g->getGateID()] == g; }
+  bool isLeaf(const CirGate* g, const unsigned* leaves, unsigned n) const {
+    for(unsigned i = 0; i < n; i++)
+      if(leaves[i] == (unsigned)g->getGateID()) return true;
+    return false;
+  }
+  int& refOf(const CirGate* g) {
+    unsigned id = g->getGateID();
+    if(_stamp[id] != _curStamp)
+      { _stamp[id] = _curStamp; _ref[id] = g->getFanout().size(); }
+    return _ref[id];
+  }
+  bool inMffc(const CirGate* g) const {
+    unsigned id = g->getGateID();
+    return _stamp[id] == _curStamp && _ref[id] == 0;
+  }
+  CirGate* lookup(const Pin& a, const Pin& b) const {
+    size_t key = StrashTable::getKey(a, b);
+    CirGate* g = _table.find(key);
+    if(g == 0 || !isAlive(g)) return 0;
+    const vector<Pin>& fanin = g->getFanin();
+    return (StrashTable::getKey(fanin[0], fanin[1]) == key)? g: 0;
+  }
+
+  bool isCutValid(CirGate*, const unsigned*, unsigned);
+  unsigned derefMffc(CirGate*, const unsigned*, unsigned);
+  int countNew(CirGate*, const NpnImpl&, const Pin*, int);
+  Pin getInput(unsigned char, const Pin*, const vector<Pin>&) const;
+  void replace(CirGate*, const NpnImpl&, const Pin*);
+  CirGate* newAig(const Pin&, const Pin&);
+  void setInputs(unsigned, unsigned, const NpnLib&, Pin*) const;
+  void rewriteGate(CirGate*, const NpnLib&);
+};
+
+/*******************************************/
+/*   class CirRewriter member functions    */
+/*******************************************/
+void
+CirRewriter::run()
+{
+   static const NpnLib npnLib;   // built on first use
+   for(int i = 0, s = _mgr->_dfsList.size(); i < s; i++){
+      CirGate* g = _mgr->_dfsList[i];
+      if(g->isAig()) _table.insert(StrashTable::getKey(g->getFanin()[0],
+                                   g->getFanin()[1]), g);
+   }
+   _cuts.enumerate(_total, _mgr->_dfsList);
+   for(int i = 0, s = _mgr->_dfsList.size(); i < s; i++){
+      CirGate* g = _mgr->_dfsList[i];
+      if(g->isAig() && isAlive(g)) rewriteGate(g, npnLib);
+   }
+   _mgr->fillIdHoles(_origSize);
+}
+
+// The leaves must still be the original gates and separate "g" from the
+// PIs; the walk is bounded so that a broken cut is rejected cheaply.
+bool
+CirRewriter::isCutValid(CirGate* g, const unsigned* leaves, unsigned n)
+{
+   for(unsigned i = 0; i < n; i++)
+      if(leaves[i] >= _origSize || _total[leaves[i]] != _snapshot[leaves[i]]
+         || _total[leaves[i]] == 0) return false;
+   ++_curStamp;
+   unsigned visited = 0;
+   _stack.clear(); _stack.push_back(g);
+   while(!_stack.empty()){
+      CirGate* c = _stack.back(); _stack.pop_back();
+      unsigned id = c->getGateID();
+      if(_stamp[id] == _curStamp || isLeaf(c, leaves, n)) continue;
+      _stamp[id] = _curStamp;
+      if(!c->isAig() || ++visited > RWR_CONE_LIMIT) return false;
+      for(int j = 0; j < 2; j++) _stack.push_back(c->getFanin()[j].getPin());
+   }
+   return true;
+}
+
+// Number of gates freed if "g" is removed; leaves the visited gates with
+// their reference counts decremented for the current stamp.
+unsigned
+CirRewriter::derefMffc(CirGate* g, const unsigned* leaves, unsigned n)
+{
+   ++_curStamp;
+   unsigned count = 0;
+   refOf(g) = 0;
+   _stack.clear(); _stack.push_back(g);
+   while(!_stack.empty()){
+      CirGate* c = _stack.back(); _stack.pop_back();
+      ++count;
+      for(int j = 0; j < 2; j++){
+         CirGate* in = c->getFanin()[j].getPin();
+         if(!in->isAig() || isLeaf(in, leaves, n)) continue;
+         if(--refOf(in) == 0) _stack.push_back(in);
+      }
+   }
+   return count;
+}
+
+Pin
+CirRewriter::getInput(unsigned char lit, const Pin* inputs,
+                      const vector<Pin>& nodes) const
+{
+   bool inv = lit & 1;
+   if(lit < 2) return Pin(_total[0], inv);
+   if(lit < 10) { const Pin& p = inputs[(lit - 2) / 2];
+                  return Pin(p.getPin(), p.getInvPhase() ^ inv); }
+   const Pin& p = nodes[(lit - 10) / 2];
+   return Pin(p.getPin(), p.getInvPhase() ^ inv);
+}
+
+// Gates the implementation would add given the gates already in the
+// netlist; a gate in the MFFC of "root" counts as new since keeping it
+// cancels its removal. Stop once "limit" is reached.
+int
+CirRewriter::countNew(CirGate* root, const NpnImpl& impl, const Pin* inputs,
+                      int limit)
+{
+   vector<Pin> nodes(impl._nNodes);
+   int count = 0;
+   for(unsigned k = 0; k < impl._nNodes; k++){
+      Pin a = getInput(impl._fanin[2*k], inputs, nodes);
+      Pin b = getInput(impl._fanin[2*k+1], inputs, nodes);
+      CirGate* g = (a.getPin() && b.getPin())? lookup(a, b): 0;
+      if(g == root) return limit;
+      if(g == 0 || inMffc(g)) { if(++count >= limit) return limit; }
+      nodes[k] = Pin(g, false);
+   }
+   Pin out = getInput(impl._out, inputs, nodes);
+   if(out.getPin() == root) return limit;
+   return count;
+}
+
+// CirMgr::addAig(), plus the hash entry and the scratch of the new gate
+CirGate*
+CirRewriter::newAig(const Pin& a, const Pin& b)
+{
+   CirGate* g = _mgr->addAig(a, b);
+   if(_stamp.size() < _total.size())
+      { _stamp.resize(_total.size(), 0); _ref.resize(_total.size(), 0); }
+   _table.set(StrashTable::getKey(a, b), g);
+   return g;
+}
+
+void
+CirRewriter::replace(CirGate* root, const NpnImpl& impl, const Pin* inputs)
+{
+   vector<Pin> nodes(impl._nNodes);
+   for(unsigned k = 0; k < impl._nNodes; k++){
+      Pin a = getInput(impl._fanin[2*k], inputs, nodes);
+      Pin b = getInput(impl._fanin[2*k+1], inputs, nodes);
+      CirGate* g = lookup(a, b);
+      nodes[k] = Pin(g? g: newAig(a, b), false);
+   }
+   Pin out = getInput(impl._out, inputs, nodes);
+   GateList oldFanin, oldFanout;
+   for(int j = 0; j < 2; j++) oldFanin.push_back(root->getFanin()[j].getPin());
+   for(int j = 0, s = root->getFanout().size(); j < s; j++)
+      oldFanout.push_back(root->getFanout()[j].getPin());
+   unsigned id = root->getGateID();
+   _mgr->mergeGate(root, out.getPin(), out.getInvPhase());
+   _mgr->_freeIds.push_back(id);
+   // fanouts now hash on new fanin literals
+   for(int j = 0, s = oldFanout.size(); j < s; j++){
+      CirGate* fo = oldFanout[j];
+      if(!fo->isAig()) continue;
+      size_t key = StrashTable::getKey(fo->getFanin()[0], fo->getFanin()[1]);
+      if(lookup(fo->getFanin()[0], fo->getFanin()[1]) == 0) _table.set(key, fo);
+   }
+   for(int j = 0; j < 2; j++) _mgr->removeDead(oldFanin[j]);
+   ++_nReplaced;
+}
+
+// Canonical input i is fed by leaf perm(i), inverted by bit i of the input
+// negation; inputs beyond the cut size are don't-cares.
+void
+CirRewriter::setInputs(unsigned id, unsigned c, const NpnLib& npnLib,
+                       Pin* inputs) const
+{
+   const CirCut& cut = _cuts.getCut(id, c);
+   const unsigned* leaves = _cuts.getLeaves(id, c);
+   uint16_t f = cut.getTruth() & 0xFFFF;
+   const unsigned char* perm = npnLib.getPerm(f);
+   unsigned neg = npnLib.getInputNeg(f);
+   for(unsigned i = 0; i < 4; i++){
+      CirGate* in = (perm[i] < cut.size())? _total[leaves[perm[i]]]: _total[0];
+      inputs[i] = Pin(in, (neg >> i) & 1);
+   }
+}
+
+void
+CirRewriter::rewriteGate(CirGate* g, const NpnLib& npnLib)
+{
+   unsigned id = g->getGateID();
+   int bestGain = 0, bestCut = -1;
+   for(unsigned c = 1, n = _cuts.getNumCuts(id); c < n; c++){
+      const CirCut& cut = _cuts.getCut(id, c);
+      const unsigned* leaves = _cuts.getLeaves(id, c);
+      if(!isCutValid(g, leaves, cut.size())) continue;
+      int mffc = derefMffc(g, leaves, cut.size());
+      uint16_t f = cut.getTruth() & 0xFFFF;
+      Pin inputs[4];
+      setInputs(id, c, npnLib, inputs);
+      int gain = mffc - countNew(g, npnLib.getImpl(f), inputs, mffc);
+      if(gain > bestGain) { bestGain = gain; bestCut = c; }
+   }
+   if(bestCut < 0) return;
+   uint16_t f = _cuts.getCut(id, bestCut).getTruth() & 0xFFFF;
+   Pin inputs[4];
+   setInputs(id, bestCut, npnLib, inputs);
+   NpnImpl impl = npnLib.getImpl(f);
+   if(npnLib.getOutputNeg(f)) impl._out ^= 1;
+   replace(g, impl, inputs);
+}
+
+/**************************************************/
+/*   Public member functions about optimization   */
+/**************************************************/
+void
+CirMgr::rewrite()
+{
+   unsigned before = 0, after = 0;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++before;
+   clock_t start = clock();
+   CirRewriter rwr(this);
+   rwr.run();
+   flushRemoved();
+   clearFecGrps();   // IDs of removed gates may have been reused
+   double t = double(clock() - start) / CLOCKS_PER_SEC;
+   for(int i = 0, s = _dfsList.size(); i < s; i++)
+      if(_dfsList[i]->isAig()) ++after;
+   cout << "Rewriting: " << rwr.getNumReplaced() << " replacement(s), AIG "
+        << before << " -> " << after << ", " << setprecision(4) << t
+        << " seconds" << endl;
+}
@@ -0,0 +1,255 @@
+/****************************************************************************
+  FileName     [ cirSim.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define cir simulation functions ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+#include "myTrace.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+#define SIM_MAX_FAILS   8
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+static bool
+firstIdLess(const IdList* a, const IdList* b)
+{
+   return (*a)[0] < (*b)[0];
+}
+
+/************************************************/
+/*   Public member functions about Simulation   */
+/************************************************/
+// Simulate 64 random patterns at a time until the FEC groups stop
+// changing for SIM_MAX_FAILS rounds in a row
+void
+CirMgr::randomSim()
+{
+   TRACE_SPAN("randomSim");
+   vector<uint64_t> words(_piList.size());
+   size_t nPatterns = 0;
+   for(unsigned fails = 0; fails < SIM_MAX_FAILS; ){
+      for(size_t i = 0, s = words.size(); i < s; i++) words[i] = simRandom();
+      simulate(words);
+      writeSimLog(words, 64);
+      nPatterns += 64;
+      if(refineFecGrps(~uint64_t(0))) fails = 0;
+      else ++fails;
+   }
+   cout << nPatterns << " patterns simulated." << endl;
+}
+
+void
+CirMgr::fileSim(ifstream& patternFile)
+{
+   TRACE_SPAN("fileSim");
+   vector<uint64_t> blocks;
+   size_t nPatterns = 0;
+   if(!readPatterns(patternFile, blocks, nPatterns)){
+      cout << "0 patterns simulated." << endl;
+      return;
+   }
+   vector<uint64_t> words(_piList.size());
+   for(size_t p = 0; p < nPatterns; p += 64){
+      unsigned n = min(size_t(64), nPatterns - p);
+      copy(blocks.begin() + (p / 64) * words.size(),
+           blocks.begin() + (p / 64 + 1) * words.size(), words.begin());
+      simulate(words);
+      writeSimLog(words, n);
+      refineFecGrps((n == 64)? ~uint64_t(0): (uint64_t(1) << n) - 1);
+   }
+   cout << nPatterns << " patterns simulated." << endl;
+}
+
+/*************************************************/
+/*   Private member functions about Simulation   */
+/*************************************************/
+// xorshift64*; seeded once so that a run can be reproduced
+uint64_t
+CirMgr::simRandom()
+{
+   static uint64_t x = 0x9E3779B97F4A7C15ULL;
+   x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+   return x * 0x2545F4914F6CDD1DULL;
+}
+
+// One pattern per token, a '0' or '1' per PI; all of them are checked
+// before any is used. "blocks" gets 64 patterns per PI word, block by
+// block (the last one padded with 0s).
+bool
+CirMgr::readPatterns(istream& patternFile, vector<uint64_t>& blocks,
+                     size_t& nPatterns) const
+{
+   size_t nPis = _piList.size();
+   string pattern;
+   blocks.clear();
+   for(nPatterns = 0; patternFile >> pattern; nPatterns++){
+      if(pattern.size() != nPis){
+         cerr << "\nError: Pattern(" << pattern << ") length(" << pattern.size()
+              << ") does not match the number of inputs(" << nPis
+              << ") in a circuit!!" << endl;
+         return false;
+      }
+      size_t pos = pattern.find_first_not_of("01");
+      if(pos != string::npos){
+         cerr << "\nError: Pattern(" << pattern << ") contains a non-0/1 "
+              << "character(\'" << pattern[pos] << "\')." << endl;
+         return false;
+      }
+      unsigned k = nPatterns % 64;
+      if(k == 0) blocks.resize(blocks.size() + nPis, 0);
+      uint64_t* words = &blocks[blocks.size() - nPis];
+      for(size_t i = 0; i < nPis; i++)
+         if(pattern[i] == '1') words[i] |= uint64_t(1) << k;
+   }
+   return true;
+}
+
+void
+CirMgr::simulate(const vector<uint64_t>& piWords)
+{
+   if(_simValue.size() != _totalList.size())
+      _simValue.assign(_totalList.size(), 0);
+   simulate(piWords.empty()? 0: &piWords[0], _simValue);
+}
+
+// UNDEF gates (never in _dfsList) and CONST0 keep the value 0
+void
+CirMgr::simulate(const uint64_t* piWords, vector<uint64_t>& value) const
+{
+   TRACE_SPAN("simulate");
+   for(size_t i = 0, s = _piList.size(); i < s; i++)
+      value[_piList[i]->getGateID()] = piWords[i];
+   for(size_t i = 0, s = _dfsList.size(); i < s; i++){
+      const CirGate* g = _dfsList[i];
+      if(!g->isAig()) continue;
+      const Pin& a = g->getFanin()[0];
+      const Pin& b = g->getFanin()[1];
+      uint64_t va = value[a.getPin()->getGateID()];
+      uint64_t vb = value[b.getPin()->getGateID()];
+      if(a.getInvPhase()) va = ~va;
+      if(b.getInvPhase()) vb = ~vb;
+      value[g->getGateID()] = va & vb;
+   }
+}
+
+// Split every group by the (masked) values just simulated. A value and its
+// complement go to the same group; the phase of a member is the value of
+// its first pattern. Return true if any group was split or dropped.
+bool
+CirMgr::refineFecGrps(uint64_t mask)
+{
+   TRACE_SPAN("refineFecGrps");
+   if(!_simulated){
+      _fecGrps.assign(1, IdList(1, 0));
+      for(size_t i = 0, s = _dfsList.size(); i < s; i++)
+         if(_dfsList[i]->isAig())
+            _fecGrps[0].push_back(_dfsList[i]->getGateID() * 2);
+      sort(_fecGrps[0].begin(), _fecGrps[0].end());
+      _simulated = true;
+   }
+   bool changed = false;
+   vector<IdList> newGrps;
+   vector<pair<uint64_t, unsigned> > keyed;
+   for(size_t i = 0, s = _fecGrps.size(); i < s; i++){
+      const IdList& grp = _fecGrps[i];
+      keyed.clear();
+      for(size_t j = 0, n = grp.size(); j < n; j++){
+         unsigned id = grp[j] / 2;
+         uint64_t v = _simValue[id] & mask;
+         keyed.push_back(make_pair((v & 1)? (~v & mask): v, id));
+      }
+      sort(keyed.begin(), keyed.end());
+      size_t nSub = 0;
+      for(size_t j = 0, n = keyed.size(); j < n; ){
+         size_t k = j + 1;
+         while(k < n && keyed[k].first == keyed[j].first) ++k;
+         if(k - j > 1){
+            newGrps.push_back(IdList());
+            IdList& sub = newGrps.back();
+            for(size_t l = j; l < k; l++){
+               unsigned id = keyed[l].second;
+               sub.push_back(id * 2 + (_simValue[id] & 1));
+            }
+            ++nSub;
+         }
+         j = k;
+      }
+      if(nSub != 1 || newGrps.back().size() != grp.size()) changed = true;
+   }
+   _fecGrps.swap(newGrps);
+   return changed;
+}
+
+// Drop the gates that were removed or are no longer reachable from a PO;
+// valid right after buildDfsList()
+void
+CirMgr::updateFecGrps()
+{
+   size_t n = 0;
+   for(size_t i = 0, s = _fecGrps.size(); i < s; i++){
+      IdList& grp = _fecGrps[i];
+      size_t m = 0;
+      for(size_t j = 0, t = grp.size(); j < t; j++){
+         unsigned id = grp[j] / 2;
+         if(id == 0 || (_totalList[id] != 0 && _totalList[id]->isGlobalRef()))
+            grp[m++] = grp[j];
+      }
+      grp.resize(m);
+      if(m > 1) _fecGrps[n++].swap(grp);
+   }
+   _fecGrps.resize(n);
+}
+
+// one line per pattern: PI values, then PO values
+void
+CirMgr::writeSimLog(const vector<uint64_t>& piWords, unsigned n) const
+{
+   if(_simLog == 0) return;
+   string line(_piList.size() + 1 + _poList.size(), ' ');
+   for(unsigned k = 0; k < n; k++){
+      for(size_t i = 0, s = _piList.size(); i < s; i++)
+         line[i] = ((piWords[i] >> k) & 1)? '1': '0';
+      for(size_t i = 0, s = _poList.size(); i < s; i++){
+         const Pin& p = _poList[i]->getFanin()[0];
+         bool v = (_simValue[p.getPin()->getGateID()] >> k) & 1;
+         line[_piList.size() + 1 + i] = (v ^ p.getInvPhase())? '1': '0';
+      }
+      *_simLog << line << '\n';
+   }
+   _simLog->flush();
+}
+
+/*************************************************/
+/*   Public member functions about FEC printing  */
+/*************************************************/
+void
+CirMgr::printFECPairs() const
+{
+   vector<const IdList*> grps;
+   for(size_t i = 0, s = _fecGrps.size(); i < s; i++)
+      grps.push_back(&_fecGrps[i]);
+   sort(grps.begin(), grps.end(), firstIdLess);
+   for(size_t i = 0, s = grps.size(); i < s; i++){
+      const IdList& grp = *grps[i];
+      cout << "[" << i << "]";
+      for(size_t j = 0, n = grp.size(); j < n; j++)
+         cout << " " << (((grp[j] ^ grp[0]) & 1)? "!": "") << grp[j] / 2;
+      cout << endl;
+   }
+}
@@ -0,0 +1,104 @@
+/****************************************************************************
+  FileName     [ cirStrash.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define open-addressing hash table for structural hashing ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_STRASH_H
+#define CIR_STRASH_H
+
+#include <vector>
+#include "cirDef.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//   class StrashTable
+//------------------------------------------------------------------------
+// Key of an AIG gate is its normalized fanin pair (min-lit, max-lit).
+// Buckets store the key next to the gate pointer so that a probe touches
+// one cache line; linear probing, size is a power of 2 and load <= 1/2.
+class StrashTable
+{
+public:
+  StrashTable(size_t n = 0) { init(n); }
+  ~StrashTable() {}
+
+  void init(size_t n) {
+    size_t cap = 16;
+    while(cap < 2 * n) cap <<= 1;
+    clearList(_buckets);
+    _buckets.resize(cap);
+    _mask = cap - 1; _size = 0;
+  }
+  size_t size() const { return _size; }
+
+  static size_t getKey(size_t l0, size_t l1) {
+    if(l0 > l1) { size_t t = l0; l0 = l1; l1 = t; }
+    return (l0 << 32) | l1;
+  }
+  static size_t getKey(const Pin& a, const Pin& b) {
+    return getKey(a.getLit(), b.getLit());
+  }
+
+  // Return the gate already hashed with "key"; otherwise insert "g" and
+  // return 0
+  CirGate* insert(size_t key, CirGate* g) {
+    if(2 * (_size + 1) > _buckets.size()) rehash();
+    size_t i = bucketNum(key);
+    while(_buckets[i]._gate != 0){
+      if(_buckets[i]._key == key) return _buckets[i]._gate;
+      i = (i + 1) & _mask;
+    }
+    _buckets[i]._key = key; _buckets[i]._gate = g; ++_size;
+    return 0;
+  }
+
+  // Insert or overwrite
+  void set(size_t key, CirGate* g) {
+    if(2 * (_size + 1) > _buckets.size()) rehash();
+    size_t i = bucketNum(key);
+    while(_buckets[i]._gate != 0){
+      if(_buckets[i]._key == key) { _buckets[i]._gate = g; return; }
+      i = (i + 1) & _mask;
+    }
+    _buckets[i]._key = key; _buckets[i]._gate = g; ++_size;
+  }
+
+  CirGate* find(size_t key) const {
+    size_t i = bucketNum(key);
+    while(_buckets[i]._gate != 0){
+      if(_buckets[i]._key == key) return _buckets[i]._gate;
+      i = (i + 1) & _mask;
+    }
+    return 0;
+  }
+
+private:
+  struct Bucket {
+    Bucket(): _key(0), _gate(0) {}
+    size_t   _key;
+    CirGate* _gate;
+  };
+  vector<Bucket> _buckets;
+  size_t         _mask;
+  size_t         _size;
+
+  size_t bucketNum(size_t key) const {
+    key *= 0x9E3779B97F4A7C15ULL;
+    return (key ^ (key >> 29)) & _mask;
+  }
+  void rehash() {
+    vector<Bucket> old;
+    old.swap(_buckets);
+    init(old.size());
+    for(size_t i = 0, s = old.size(); i < s; i++)
+      if(old[i]._gate != 0) insert(old[i]._key, old[i]._gate);
+  }
+};
+
+#endif // CIR_STRASH_H
@@ -0,0 +1,139 @@
+/****************************************************************************
+  FileName     [ cirSupport.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define structural support computation ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <cassert>
+#include "cirMgr.h"
+#include "cirGate.h"
+#include "util.h"
+
+using namespace std;
+
+/*******************************/
+/*   Global variable and enum  */
+/*******************************/
+// largest bitset pool (in bytes) before switching to sparse sets
+#define SUPPORT_DENSE_BYTES   (size_t(1) << 28)
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+// Supports as PI indices, one packed bitset per gate of "dfsList" in a
+// single pool; UNDEF and CONST0 have an empty support
+static void
+denseSupport(const GateList& dfsList, const GateList& piList,
+             const GateList& poList, size_t nGates, vector<IdList>& poSupport)
+{
+   size_t nWords = (piList.size() + 63) / 64;
+   vector<size_t> slot(nGates, 0);   // 0: empty support
+   vector<uint64_t> pool(nWords, 0);
+   for(size_t i = 0, s = dfsList.size(); i < s; i++){
+      const CirGate* g = dfsList[i];
+      if(g->getType() == PI_GATE || g->isAig()){
+         slot[g->getGateID()] = pool.size();
+         pool.resize(pool.size() + nWords, 0);
+      }
+   }
+   for(size_t i = 0, s = piList.size(); i < s; i++){
+      size_t p = slot[piList[i]->getGateID()];
+      if(p) pool[p + i / 64] |= uint64_t(1) << (i % 64);
+   }
+   for(size_t i = 0, s = dfsList.size(); i < s; i++){
+      const CirGate* g = dfsList[i];
+      if(!g->isAig()) continue;
+      const vector<Pin>& fanin = g->getFanin();
+      uint64_t* r = &pool[slot[g->getGateID()]];
+      const uint64_t* a = &pool[slot[fanin[0].getPin()->getGateID()]];
+      const uint64_t* b = &pool[slot[fanin[1].getPin()->getGateID()]];
+      for(size_t w = 0; w < nWords; w++) r[w] = a[w] | b[w];
+   }
+   poSupport.assign(poList.size(), IdList());
+   for(size_t i = 0, s = poList.size(); i < s; i++){
+      const uint64_t* a = &pool[slot[poList[i]->getFanin()[0].getPin()
+                                        ->getGateID()]];
+      for(size_t w = 0; w < nWords; w++)
+         for(uint64_t v = a[w]; v; v &= v - 1)
+            poSupport[i].push_back(w * 64 + __builtin_ctzll(v));
+   }
+}
+
+// The same with sorted lists, for circuits too wide for the bitsets
+static void
+sparseSupport(const GateList& dfsList, const GateList& piList,
+              const GateList& poList, size_t nGates, vector<IdList>& poSupport)
+{
+   vector<IdList> sup(nGates);
+   for(size_t i = 0, s = piList.size(); i < s; i++)
+      sup[piList[i]->getGateID()].assign(1, i);
+   for(size_t i = 0, s = dfsList.size(); i < s; i++){
+      const CirGate* g = dfsList[i];
+      if(!g->isAig()) continue;
+      const vector<Pin>& fanin = g->getFanin();
+      const IdList& a = sup[fanin[0].getPin()->getGateID()];
+      const IdList& b = sup[fanin[1].getPin()->getGateID()];
+      IdList& r = sup[g->getGateID()];
+      set_union(a.begin(), a.end(), b.begin(), b.end(), back_inserter(r));
+   }
+   poSupport.assign(poList.size(), IdList());
+   for(size_t i = 0, s = poList.size(); i < s; i++)
+      poSupport[i] = sup[poList[i]->getFanin()[0].getPin()->getGateID()];
+}
+
+/*********************************************/
+/*   Public member functions about support   */
+/*********************************************/
+// One line per PO: the IDs of the PIs in its transitive fanin, with runs
+// of consecutive IDs printed as ranges
+void
+CirMgr::printSupport() const
+{
+   size_t nGates = _totalList.size();
+   size_t nWords = (_piList.size() + 63) / 64;
+   bool dense = (_dfsList.size() + 1) * nWords * 8 <= SUPPORT_DENSE_BYTES;
+   vector<IdList> poSupport;
+   if(dense) denseSupport(_dfsList, _piList, _poList, nGates, poSupport);
+   else sparseSupport(_dfsList, _piList, _poList, nGates, poSupport);
+
+   ostringstream oss;
+   size_t total = 0, maxSize = 0;
+   IdList ids;
+   for(size_t i = 0, s = _poList.size(); i < s; i++){
+      const IdList& sup = poSupport[i];
+      ids.clear();
+      for(size_t j = 0, n = sup.size(); j < n; j++)
+         ids.push_back(_piList[sup[j]]->getGateID());
+      sort(ids.begin(), ids.end());
+      oss << "PO " << _poList[i]->getGateID();
+      if(!_poList[i]->getSymbols().empty())
+         oss << " (" << _poList[i]->getSymbols() << ")";
+      oss << ": " << ids.size() << " PI(s)";
+      if(!ids.empty()) oss << ":";
+      for(size_t j = 0, n = ids.size(); j < n; ){
+         size_t k = j + 1;
+         while(k < n && ids[k] == ids[j] + (k - j)) ++k;
+         oss << " " << ids[j];
+         if(k - j > 1) oss << "-" << ids[k - 1];
+         j = k;
+      }
+      oss << '\n';
+      total += ids.size();
+      maxSize = max(maxSize, ids.size());
+   }
+   cout << oss.str();
+   cout << "Support: " << _poList.size() << " PO(s), at most " << maxSize
+        << " and " << fixed << setprecision(2)
+        << (_poList.empty()? 0.0: double(total) / _poList.size())
+        << " PI(s) on average (" << (dense? "bitsets": "sparse sets") << ")"
+        << endl;
+   cout.unsetf(ios::fixed);
+   cout << setprecision(6);
+}
@@ -1 +1,4 @@
-main.o: main.cpp ../../include/cmdParser.h ../../include/cmdCharDef.h
+main.o: main.cpp ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h ../../include/myProfile.h \
+ ../../include/cmdParser.h ../../include/cmdCharDef.h \
+ ../../include/cmdParser.h
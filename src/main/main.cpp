@@ -8,6 +8,7 @@
 
 #include <cstdlib>
 #include "util.h"
+#include "myProfile.h"
 #include "cmdParser.h"
 
 using namespace std;
@@ -19,11 +20,12 @@ CmdParser* cmdMgr = new CmdParser("cir> ");
 
 extern bool initCommonCmd();
 extern bool initCirCmd();
+extern bool initSatCmd();
 
 static void
 usage()
 {
-   cout << "Usage: cirTest [ -File < doFile > ]" << endl;
+   cout << "Usage: cirTest [ -Profile ] [ -File < doFile > ]" << endl;
 }
 
 static void
@@ -40,6 +42,10 @@ main(int argc, char** argv)
 
    ifstream dof;
 
+   if (argc > 1 && myStrNCmp("-Profile", argv[1], 2) == 0) {
+      myProfile.enable(true);  // also reported when quitting
+      --argc; ++argv;
+   }
    if (argc == 3) {  // -file <doFile>
       if (myStrNCmp("-File", argv[1], 2) == 0) {
          if (!cmdMgr->openDofile(argv[2])) {
@@ -57,7 +63,7 @@ main(int argc, char** argv)
       myexit();
    }
 
-   if (!initCommonCmd() || !initCirCmd())
+   if (!initCommonCmd() || !initCirCmd() || !initSatCmd())
       return 1;
 
    CmdExecStatus status = CMD_EXEC_DONE;
@@ -65,6 +71,8 @@ main(int argc, char** argv)
       status = cmdMgr->execOneCmd();
       cout << endl;  // a blank line between each command
    }
+   if (myProfile.isUsed())
+      myProfile.report(cout);
 
    return 0;
 }
@@ -0,0 +1,5 @@
+sat.o: sat.cpp sat.h
+satCmd.o: satCmd.cpp sat.h satCmd.h ../../include/cmdParser.h \
+ ../../include/cmdCharDef.h ../../include/util.h ../../include/rnGen.h \
+ ../../include/myUsage.h ../../include/myProfile.h \
+ ../../include/cmdParser.h
@@ -0,0 +1,589 @@
+/****************************************************************************
+  FileName     [ sat.cpp ]
+  PackageName  [ sat ]
+  Synopsis     [ Define a CDCL SAT solver ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2010-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <ctime>
+#include "sat.h"
+
+using namespace std;
+
+/**************************************/
+/*   Static varaibles and functions   */
+/**************************************/
+#define SAT_RESTART_BASE   100
+#define SAT_REDUCE_FIRST   2000
+#define SAT_REDUCE_INC     300
+
+// Luby sequence 1 1 2 1 1 2 4 1 1 2 ...; returns its x-th element
+static uint64_t
+luby(uint64_t x)
+{
+   uint64_t size = 1, seq = 0;
+   while(size < x + 1) { ++seq; size = 2 * size + 1; }
+   while(size - 1 != x){
+      size = (size - 1) >> 1;
+      --seq;
+      x = x % size;
+   }
+   return uint64_t(1) << seq;
+}
+
+/*****************************************/
+/*   class SatVarHeap member functions   */
+/*****************************************/
+void
+SatVarHeap::insert(Var v)
+{
+   grow(v);
+   if(inHeap(v)) return;
+   _index[v] = _heap.size();
+   _heap.push_back(v);
+   percolateUp(_index[v]);
+}
+
+Var
+SatVarHeap::removeMax()
+{
+   Var v = _heap[0];
+   _heap[0] = _heap.back();
+   _index[_heap[0]] = 0;
+   _index[v] = -1;
+   _heap.pop_back();
+   if(_heap.size() > 1) percolateDown(0);
+   return v;
+}
+
+void
+SatVarHeap::clear()
+{
+   for(size_t i = 0, s = _heap.size(); i < s; i++) _index[_heap[i]] = -1;
+   _heap.clear();
+}
+
+void
+SatVarHeap::percolateUp(int i)
+{
+   Var v = _heap[i];
+   while(i > 0){
+      int p = (i - 1) >> 1;
+      if(_act[_heap[p]] >= _act[v]) break;
+      _heap[i] = _heap[p]; _index[_heap[i]] = i;
+      i = p;
+   }
+   _heap[i] = v; _index[v] = i;
+}
+
+void
+SatVarHeap::percolateDown(int i)
+{
+   Var v = _heap[i];
+   int n = _heap.size();
+   while(2 * i + 1 < n){
+      int c = 2 * i + 1;
+      if(c + 1 < n && _act[_heap[c + 1]] > _act[_heap[c]]) ++c;
+      if(_act[_heap[c]] <= _act[v]) break;
+      _heap[i] = _heap[c]; _index[_heap[i]] = i;
+      i = c;
+   }
+   _heap[i] = v; _index[v] = i;
+}
+
+/****************************************/
+/*   class SatSolver member functions   */
+/****************************************/
+SatSolver::SatSolver(): _order(_activity)
+{
+   reset();
+}
+
+void
+SatSolver::reset()
+{
+   _ok = true;
+   _arena.clear(); _wasted = 0;
+   _clauses.clear(); _learnts.clear(); _watches.clear();
+   _assigns.clear(); _polarity.clear(); _level.clear(); _reason.clear();
+   _trail.clear(); _trailLim.clear(); _qhead = 0;
+   _assumps.clear(); _active = &_assumps; _model.clear();
+   _activity.clear(); _varInc = 1; _order.clear();
+   _seen.clear(); _levelStamp.assign(1, 0); _curStamp = 0;
+   _nSolves = _nDecisions = _nPropagations = _nConflicts = 0;
+   _nRestarts = _nReduces = 0;
+   _nextReduce = SAT_REDUCE_FIRST;
+   _solveTime = 0;
+}
+
+Var
+SatSolver::newVar()
+{
+   Var v = _assigns.size();
+   _assigns.push_back(SAT_UNDEF);
+   _polarity.push_back(1);   // try "false" first
+   _level.push_back(0);
+   _reason.push_back(SAT_CLAUSE_NONE);
+   _activity.push_back(0);
+   _seen.push_back(0);
+   _watches.resize(2 * (v + 1));
+   _levelStamp.push_back(0);
+   _order.insert(v);
+   return v;
+}
+
+// Only at decision level 0. "lits" is simplified in place.
+bool
+SatSolver::addClause(vector<Lit>& lits)
+{
+   assert(decisionLevel() == 0);
+   if(!_ok) return false;
+   sort(lits.begin(), lits.end());
+   size_t n = 0;
+   for(size_t i = 0, s = lits.size(); i < s; i++){
+      Lit l = lits[i];
+      assert(litVar(l) < (Var)_assigns.size());
+      if(litValue(l) == SAT_TRUE || (n > 0 && lits[n-1] == (l ^ 1)))
+         return true;   // satisfied or tautology
+      if(litValue(l) == SAT_FALSE || (n > 0 && lits[n-1] == l)) continue;
+      lits[n++] = l;
+   }
+   lits.resize(n);
+   if(n == 0) return (_ok = false);
+   if(n == 1){
+      enqueue(lits[0], SAT_CLAUSE_NONE);
+      return (_ok = (propagate() == SAT_CLAUSE_NONE));
+   }
+   ClauseRef c = allocClause(lits, false, 0);
+   _clauses.push_back(c);
+   attachClause(c);
+   return true;
+}
+
+bool
+SatSolver::addClause(Lit a, Lit b, Lit c)
+{
+   _tmpLits.assign(1, a); _tmpLits.push_back(b); _tmpLits.push_back(c);
+   return addClause(_tmpLits);
+}
+
+void
+SatSolver::addAigCNF(Var vf, Var va, bool fa, Var vb, bool fb)
+{
+   Lit f = mkLit(vf), a = mkLit(va, fa), b = mkLit(vb, fb);
+   addClause(f ^ 1, a);
+   addClause(f ^ 1, b);
+   addClause(f, a ^ 1, b ^ 1);
+}
+
+void
+SatSolver::addXorCNF(Var vf, Var va, bool fa, Var vb, bool fb)
+{
+   Lit f = mkLit(vf), a = mkLit(va, fa), b = mkLit(vb, fb);
+   addClause(f ^ 1, a, b);
+   addClause(f ^ 1, a ^ 1, b ^ 1);
+   addClause(f, a ^ 1, b);
+   addClause(f, a, b ^ 1);
+}
+
+// DIMACS CNF; variable i in the file is Var i - 1 here
+bool
+SatSolver::readDimacs(istream& is)
+{
+   string tok;
+   vector<Lit> lits;
+   while(is >> tok){
+      if(tok == "c"){ getline(is, tok); continue; }
+      if(tok == "p"){
+         size_t nVars, nClauses;
+         if(!(is >> tok >> nVars >> nClauses) || tok != "cnf") return false;
+         while(getNumVars() < nVars) newVar();
+         continue;
+      }
+      int x = atoi(tok.c_str());
+      if(x == 0){
+         if(tok != "0") return false;
+         addClause(lits);
+         lits.clear();
+         continue;
+      }
+      Var v = abs(x) - 1;
+      while((Var)getNumVars() <= v) newVar();
+      lits.push_back(mkLit(v, x < 0));
+   }
+   return lits.empty();
+}
+
+ClauseRef
+SatSolver::allocClause(const vector<Lit>& lits, bool learnt, uint32_t lbd)
+{
+   ClauseRef c = _arena.size();
+   _arena.push_back((uint32_t(lits.size()) << 2) | (learnt? 2: 0));
+   _arena.push_back(lbd);
+   _arena.insert(_arena.end(), lits.begin(), lits.end());
+   return c;
+}
+
+void
+SatSolver::attachClause(ClauseRef c)
+{
+   const Lit* lits = clauseLits(c);
+   _watches[lits[0] ^ 1].push_back(Watcher(c, lits[1]));
+   _watches[lits[1] ^ 1].push_back(Watcher(c, lits[0]));
+}
+
+bool
+SatSolver::isLocked(ClauseRef c) const
+{
+   Lit l = clauseLits(c)[0];
+   return litValue(l) == SAT_TRUE && _reason[litVar(l)] == c;
+}
+
+// Move the live clauses to a fresh arena. Watches are rebuilt; reasons are
+// forwarded through the old header, which is free once the clause moved.
+void
+SatSolver::collectGarbage()
+{
+   vector<uint32_t> to;
+   to.reserve(_arena.size() - _wasted);
+   vector<ClauseRef>* lists[2] = { &_clauses, &_learnts };
+   for(int k = 0; k < 2; k++){
+      vector<ClauseRef>& l = *lists[k];
+      size_t n = 0;
+      for(size_t i = 0, s = l.size(); i < s; i++){
+         ClauseRef c = l[i];
+         if(isDeleted(c)) continue;
+         ClauseRef d = to.size();
+         to.insert(to.end(), &_arena[c], &_arena[c] + 2 + clauseSize(c));
+         _arena[c + 1] = d;
+         l[n++] = d;
+      }
+      l.resize(n);
+   }
+   for(size_t i = 0, s = _trail.size(); i < s; i++){
+      Var v = litVar(_trail[i]);
+      if(_reason[v] != SAT_CLAUSE_NONE) _reason[v] = _arena[_reason[v] + 1];
+   }
+   _arena.swap(to);
+   _wasted = 0;
+   for(size_t i = 0, s = _watches.size(); i < s; i++) _watches[i].clear();
+   for(size_t i = 0, s = _clauses.size(); i < s; i++) attachClause(_clauses[i]);
+   for(size_t i = 0, s = _learnts.size(); i < s; i++) attachClause(_learnts[i]);
+}
+
+void
+SatSolver::enqueue(Lit l, ClauseRef from)
+{
+   Var v = litVar(l);
+   assert(_assigns[v] == SAT_UNDEF);
+   _assigns[v] = !litInv(l);
+   _level[v] = decisionLevel();
+   _reason[v] = from;
+   _trail.push_back(l);
+}
+
+void
+SatSolver::cancelUntil(int level)
+{
+   if(decisionLevel() <= level) return;
+   for(int i = _trail.size() - 1; i >= _trailLim[level]; i--){
+      Var v = litVar(_trail[i]);
+      _polarity[v] = litInv(_trail[i]);
+      _assigns[v] = SAT_UNDEF;
+      _reason[v] = SAT_CLAUSE_NONE;
+      _order.insert(v);
+   }
+   _qhead = _trailLim[level];
+   _trail.resize(_qhead);
+   _trailLim.resize(level);
+}
+
+// Return the conflicting clause, or SAT_CLAUSE_NONE
+ClauseRef
+SatSolver::propagate()
+{
+   ClauseRef confl = SAT_CLAUSE_NONE;
+   while(_qhead < _trail.size()){
+      Lit p = _trail[_qhead++], falseLit = p ^ 1;
+      vector<Watcher>& ws = _watches[p];
+      ++_nPropagations;
+      size_t i = 0, j = 0, s = ws.size();
+      while(i < s){
+         Watcher w = ws[i++];
+         if(litValue(w._blocker) == SAT_TRUE) { ws[j++] = w; continue; }
+         Lit* lits = clauseLits(w._cref);
+         if(lits[0] == falseLit) { lits[0] = lits[1]; lits[1] = falseLit; }
+         Lit first = lits[0];
+         Watcher nw(w._cref, first);
+         if(first != w._blocker && litValue(first) == SAT_TRUE)
+            { ws[j++] = nw; continue; }
+         bool moved = false;
+         for(uint32_t k = 2, n = clauseSize(w._cref); k < n; k++){
+            if(litValue(lits[k]) != SAT_FALSE){
+               lits[1] = lits[k]; lits[k] = falseLit;
+               _watches[lits[1] ^ 1].push_back(nw);
+               moved = true;
+               break;
+            }
+         }
+         if(moved) continue;
+         ws[j++] = nw;
+         if(litValue(first) == SAT_FALSE){
+            confl = w._cref;
+            _qhead = _trail.size();
+            while(i < s) ws[j++] = ws[i++];
+         }
+         else enqueue(first, w._cref);
+      }
+      ws.resize(j);
+   }
+   return confl;
+}
+
+void
+SatSolver::bumpVar(Var v)
+{
+   if((_activity[v] += _varInc) > 1e100){
+      for(size_t i = 0, s = _activity.size(); i < s; i++) _activity[i] *= 1e-100;
+      _varInc *= 1e-100;
+   }
+   _order.increase(v);
+}
+
+// First-UIP learning. _learnt[0] is the asserting literal and _learnt[1] the
+// literal of the highest remaining level, so the clause can be watched
+// right after backtracking.
+void
+SatSolver::analyze(ClauseRef confl, int& btLevel, uint32_t& lbd)
+{
+   int pathC = 0;
+   Lit p = SAT_LIT_UNDEF;
+   int index = _trail.size() - 1;
+   _learnt.assign(1, SAT_LIT_UNDEF);
+   do {
+      assert(confl != SAT_CLAUSE_NONE);
+      if(isLearnt(confl) && clauseLbd(confl) > 2){
+         // the clause took part in a conflict again; tighten its glue
+         uint32_t l = 0;
+         ++_curStamp;
+         const Lit* lits = clauseLits(confl);
+         for(uint32_t k = 0, n = clauseSize(confl); k < n; k++){
+            int lv = _level[litVar(lits[k])];
+            if(_levelStamp[lv] != _curStamp) { _levelStamp[lv] = _curStamp; ++l; }
+         }
+         if(l < clauseLbd(confl)) clauseLbd(confl) = l;
+      }
+      const Lit* lits = clauseLits(confl);
+      for(uint32_t k = (p == SAT_LIT_UNDEF)? 0: 1, n = clauseSize(confl);
+          k < n; k++){
+         Lit q = lits[k];
+         Var v = litVar(q);
+         if(_seen[v] || _level[v] == 0) continue;
+         _seen[v] = 1;
+         bumpVar(v);
+         if(_level[v] >= decisionLevel()) ++pathC;
+         else _learnt.push_back(q);
+      }
+      while(!_seen[litVar(_trail[index--])]);
+      p = _trail[index + 1];
+      confl = _reason[litVar(p)];
+      _seen[litVar(p)] = 0;
+      --pathC;
+   } while(pathC > 0);
+   _learnt[0] = p ^ 1;
+
+   // drop literals implied by the rest of the clause
+   uint32_t absLevels = 0;
+   for(size_t i = 1, s = _learnt.size(); i < s; i++)
+      absLevels |= abstractLevel(litVar(_learnt[i]));
+   _toClear.assign(_learnt.begin(), _learnt.end());
+   size_t n = 1;
+   for(size_t i = 1, s = _learnt.size(); i < s; i++){
+      Var v = litVar(_learnt[i]);
+      if(_reason[v] == SAT_CLAUSE_NONE || !isRedundant(_learnt[i], absLevels))
+         _learnt[n++] = _learnt[i];
+   }
+   _learnt.resize(n);
+   for(size_t i = 0, s = _toClear.size(); i < s; i++)
+      _seen[litVar(_toClear[i])] = 0;
+
+   btLevel = 0;
+   if(_learnt.size() > 1){
+      size_t maxI = 1;
+      for(size_t i = 2, s = _learnt.size(); i < s; i++)
+         if(_level[litVar(_learnt[i])] > _level[litVar(_learnt[maxI])])
+            maxI = i;
+      swap(_learnt[1], _learnt[maxI]);
+      btLevel = _level[litVar(_learnt[1])];
+   }
+   ++_curStamp;
+   lbd = 0;
+   for(size_t i = 0, s = _learnt.size(); i < s; i++){
+      int lv = _level[litVar(_learnt[i])];
+      if(_levelStamp[lv] != _curStamp) { _levelStamp[lv] = _curStamp; ++lbd; }
+   }
+}
+
+// Is "l" implied by the seen literals? Walks its implication graph with an
+// explicit stack; the abstraction of levels prunes hopeless branches early.
+bool
+SatSolver::isRedundant(Lit l, uint32_t absLevels)
+{
+   _stack.assign(1, l);
+   size_t top = _toClear.size();
+   while(!_stack.empty()){
+      Var v = litVar(_stack.back()); _stack.pop_back();
+      ClauseRef c = _reason[v];
+      const Lit* lits = clauseLits(c);
+      for(uint32_t k = 1, n = clauseSize(c); k < n; k++){
+         Var u = litVar(lits[k]);
+         if(_seen[u] || _level[u] == 0) continue;
+         if(_reason[u] != SAT_CLAUSE_NONE && (abstractLevel(u) & absLevels)){
+            _seen[u] = 1;
+            _stack.push_back(lits[k]);
+            _toClear.push_back(lits[k]);
+         }
+         else {
+            for(size_t i = top, s = _toClear.size(); i < s; i++)
+               _seen[litVar(_toClear[i])] = 0;
+            _toClear.resize(top);
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+Lit
+SatSolver::pickBranchLit()
+{
+   while(!_order.empty()){
+      Var v = _order.removeMax();
+      if(_assigns[v] == SAT_UNDEF) return mkLit(v, _polarity[v]);
+   }
+   return SAT_LIT_UNDEF;
+}
+
+// Keep glue clauses (LBD <= 2) and reasons; drop the worse half of the rest
+void
+SatSolver::reduceDB()
+{
+   vector<pair<uint64_t, ClauseRef> > cand;
+   size_t n = 0;
+   for(size_t i = 0, s = _learnts.size(); i < s; i++){
+      ClauseRef c = _learnts[i];
+      if(clauseLbd(c) <= 2 || isLocked(c)) _learnts[n++] = c;
+      else cand.push_back(make_pair((uint64_t(clauseLbd(c)) << 32)
+                                    | clauseSize(c), c));
+   }
+   sort(cand.begin(), cand.end());
+   size_t keep = cand.size() / 2;
+   for(size_t i = 0, s = cand.size(); i < s; i++){
+      ClauseRef c = cand[i].second;
+      if(i < keep) _learnts[n++] = c;
+      else { _arena[c] |= 1; _wasted += 2 + clauseSize(c); }
+   }
+   _learnts.resize(n);
+   collectGarbage();
+   ++_nReduces;
+}
+
+// Return SAT_TRUE/SAT_FALSE, or SAT_UNDEF to restart
+int
+SatSolver::search(uint64_t nConflicts)
+{
+   uint64_t conflictC = 0;
+   int btLevel;
+   uint32_t lbd;
+   while(true){
+      ClauseRef confl = propagate();
+      if(confl != SAT_CLAUSE_NONE){
+         ++_nConflicts; ++conflictC;
+         if(decisionLevel() == 0) { _ok = false; return SAT_FALSE; }
+         analyze(confl, btLevel, lbd);
+         cancelUntil(btLevel);
+         if(_learnt.size() == 1) enqueue(_learnt[0], SAT_CLAUSE_NONE);
+         else {
+            ClauseRef c = allocClause(_learnt, true, lbd);
+            _learnts.push_back(c);
+            attachClause(c);
+            enqueue(_learnt[0], c);
+         }
+         decayVars();
+         continue;
+      }
+      if(conflictC >= nConflicts) { cancelUntil(0); return SAT_UNDEF; }
+      if(_nConflicts >= _nextReduce){
+         _nextReduce = _nConflicts + SAT_REDUCE_FIRST
+                     + SAT_REDUCE_INC * (_nReduces + 1);
+         reduceDB();
+      }
+      Lit next = SAT_LIT_UNDEF;
+      while(decisionLevel() < (int)_active->size()){
+         Lit a = (*_active)[decisionLevel()];
+         int val = litValue(a);
+         if(val == SAT_TRUE) newDecisionLevel();   // dummy level
+         else if(val == SAT_FALSE) return SAT_FALSE;
+         else { next = a; break; }
+      }
+      if(next == SAT_LIT_UNDEF){
+         ++_nDecisions;
+         next = pickBranchLit();
+         if(next == SAT_LIT_UNDEF) return SAT_TRUE;
+      }
+      newDecisionLevel();
+      enqueue(next, SAT_CLAUSE_NONE);
+   }
+}
+
+int
+SatSolver::solveLimited(const vector<Lit>& assumps, uint64_t maxConflicts)
+{
+   ++_nSolves;
+   _model.clear();
+   if(!_ok) return 0;
+   clock_t start = clock();
+   _active = &assumps;
+   int status = SAT_UNDEF;
+   uint64_t used = 0;
+   for(uint64_t r = 0; status == SAT_UNDEF && used < maxConflicts; r++){
+      uint64_t before = _nConflicts;
+      status = search(min(luby(r) * SAT_RESTART_BASE, maxConflicts - used));
+      used += _nConflicts - before;
+      if(status == SAT_UNDEF) ++_nRestarts;
+   }
+   if(status == SAT_TRUE) _model = _assigns;
+   cancelUntil(0);
+   _solveTime += double(clock() - start) / CLOCKS_PER_SEC;
+   return (status == SAT_UNDEF)? -1: (status == SAT_TRUE);
+}
+
+void
+SatSolver::printStats() const
+{
+   cout << "==============================[ SAT Statistics ]"
+        << "==============================" << endl;
+   cout << "Variables    : " << getNumVars() << endl;
+   cout << "Clauses      : " << _clauses.size() << " original, "
+        << _learnts.size() << " learnt" << endl;
+   cout << "Solves       : " << _nSolves << endl;
+   cout << "Decisions    : " << _nDecisions << endl;
+   cout << "Propagations : " << _nPropagations << endl;
+   cout << "Conflicts    : " << _nConflicts << endl;
+   cout << "Restarts     : " << _nRestarts << endl;
+   cout << "Reductions   : " << _nReduces << endl;
+   cout << "Time         : " << fixed << setprecision(4) << _solveTime
+        << " seconds";
+   if(_solveTime > 0)
+      cout << " (" << setprecision(0) << _nConflicts / _solveTime
+           << " conflicts/s)";
+   cout << endl;
+   cout.unsetf(ios::fixed);
+   cout << setprecision(6);
+}
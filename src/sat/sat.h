@@ -0,0 +1,196 @@
+/****************************************************************************
+  FileName     [ sat.h ]
+  PackageName  [ sat ]
+  Synopsis     [ Define a CDCL SAT solver ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2010-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef SAT_H
+#define SAT_H
+
+#include <vector>
+#include <iostream>
+#include <stdint.h>
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//   Variables, literals and clause references
+//------------------------------------------------------------------------
+// Literal of variable v is 2v (positive) or 2v+1 (negative), as in AIGER.
+typedef int       Var;
+typedef uint32_t  Lit;
+typedef uint32_t  ClauseRef;
+
+#define SAT_LIT_UNDEF     (~Lit(0))
+#define SAT_CLAUSE_NONE   (~ClauseRef(0))
+#define SAT_NO_LIMIT      (~uint64_t(0))
+
+inline Lit  mkLit(Var v, bool inv = false) { return (Lit(v) << 1) | Lit(inv); }
+inline Var  litVar(Lit l) { return Var(l >> 1); }
+inline bool litInv(Lit l) { return l & 1; }
+
+//------------------------------------------------------------------------
+//   class SatVarHeap
+//------------------------------------------------------------------------
+// Binary max-heap of variables keyed by their VSIDS activity
+class SatVarHeap
+{
+public:
+  SatVarHeap(const vector<double>& act): _act(act) {}
+
+  bool empty() const { return _heap.empty(); }
+  bool inHeap(Var v) const
+    { return v < (Var)_index.size() && _index[v] >= 0; }
+  void grow(Var v) { if(v >= (Var)_index.size()) _index.resize(v + 1, -1); }
+  void insert(Var v);
+  void increase(Var v) { if(inHeap(v)) percolateUp(_index[v]); }
+  Var removeMax();
+  void clear();
+
+private:
+  const vector<double>&  _act;
+  vector<Var>            _heap;
+  vector<int>            _index;   // position in _heap, -1 if absent
+
+  void percolateUp(int);
+  void percolateDown(int);
+};
+
+//------------------------------------------------------------------------
+//   class SatSolver
+//------------------------------------------------------------------------
+// Conflict-driven clause learning with two watched literals (plus a
+// blocking literal per watch), VSIDS branching with phase saving, Luby
+// restarts and LBD-based reduction of learnt clauses. Clauses live in one
+// arena of 32-bit words: [size|learnt|deleted] [lbd] lits...
+// Clauses may be added between calls at decision level 0, and a call may
+// be made under assumptions, so one instance serves many related queries.
+class SatSolver
+{
+public:
+  SatSolver();
+  ~SatSolver() {}
+
+  // Construction
+  void initialize() { reset(); }
+  void reset();
+  Var newVar();
+  size_t getNumVars() const { return _assigns.size(); }
+  size_t getNumClauses() const { return _clauses.size(); }
+  bool addClause(vector<Lit>&);
+  bool addClause(Lit a) { _tmpLits.assign(1, a); return addClause(_tmpLits); }
+  bool addClause(Lit a, Lit b)
+    { _tmpLits.assign(1, a); _tmpLits.push_back(b); return addClause(_tmpLits); }
+  bool addClause(Lit, Lit, Lit);
+  // vf = (va ^ fa) & (vb ^ fb)
+  void addAigCNF(Var vf, Var va, bool fa, Var vb, bool fb);
+  // vf = (va ^ fa) ^ (vb ^ fb)
+  void addXorCNF(Var vf, Var va, bool fa, Var vb, bool fb);
+  bool readDimacs(istream&);
+
+  // Solving
+  void assumeRelease() { _assumps.clear(); }
+  void assumeProperty(Var v, bool val) { _assumps.push_back(mkLit(v, !val)); }
+  bool assumpSolve() { return solve(_assumps); }
+  bool solve() { vector<Lit> none; return solve(none); }
+  bool solve(const vector<Lit>& assumps)
+    { return solveLimited(assumps, SAT_NO_LIMIT) == 1; }
+  // 1 if satisfiable, 0 if not, -1 if "maxConflicts" conflicts were
+  // reached first (the learnt clauses are kept for the next call)
+  int assumpSolveLimited(uint64_t maxConflicts)
+    { return solveLimited(_assumps, maxConflicts); }
+  int solveLimited(const vector<Lit>& assumps, uint64_t maxConflicts);
+  // 1/0 in the last model; -1 if the variable was not assigned
+  int getValue(Var v) const
+    { return (v < (Var)_model.size() && _model[v] != SAT_UNDEF)? _model[v]: -1; }
+
+  void printStats() const;
+
+private:
+  enum { SAT_FALSE = 0, SAT_TRUE = 1, SAT_UNDEF = 2 };
+
+  struct Watcher {
+    Watcher(ClauseRef c = SAT_CLAUSE_NONE, Lit b = SAT_LIT_UNDEF)
+      : _cref(c), _blocker(b) {}
+    ClauseRef  _cref;
+    Lit        _blocker;
+  };
+
+  bool                      _ok;       // false once level 0 is conflicting
+  vector<uint32_t>          _arena;
+  size_t                    _wasted;   // words of deleted clauses
+  vector<ClauseRef>         _clauses;
+  vector<ClauseRef>         _learnts;
+  vector<vector<Watcher> >  _watches;  // _watches[l]: clauses watching ~l
+
+  vector<char>              _assigns;
+  vector<char>              _polarity;
+  vector<int>               _level;
+  vector<ClauseRef>         _reason;
+  vector<Lit>               _trail;
+  vector<int>               _trailLim;
+  size_t                    _qhead;
+  vector<Lit>               _assumps;  // by assumeProperty()
+  const vector<Lit>*        _active;   // assumptions of the running solve
+  vector<char>              _model;
+
+  vector<double>            _activity;
+  double                    _varInc;
+  SatVarHeap                _order;
+
+  // scratch for analysis
+  vector<char>              _seen;
+  vector<Lit>               _learnt;
+  vector<Lit>               _stack;
+  vector<Lit>               _toClear;
+  vector<unsigned>          _levelStamp;
+  unsigned                  _curStamp;
+  vector<Lit>               _tmpLits;
+
+  // statistics and schedules
+  uint64_t                  _nSolves;
+  uint64_t                  _nDecisions;
+  uint64_t                  _nPropagations;
+  uint64_t                  _nConflicts;
+  uint64_t                  _nRestarts;
+  uint64_t                  _nReduces;
+  uint64_t                  _nextReduce;
+  double                    _solveTime;
+
+  // clause arena
+  uint32_t clauseSize(ClauseRef c) const { return _arena[c] >> 2; }
+  bool isLearnt(ClauseRef c) const { return _arena[c] & 2; }
+  bool isDeleted(ClauseRef c) const { return _arena[c] & 1; }
+  uint32_t& clauseLbd(ClauseRef c) { return _arena[c + 1]; }
+  Lit* clauseLits(ClauseRef c) { return &_arena[c + 2]; }
+  const Lit* clauseLits(ClauseRef c) const { return &_arena[c + 2]; }
+  ClauseRef allocClause(const vector<Lit>&, bool learnt, uint32_t lbd);
+  void attachClause(ClauseRef);
+  bool isLocked(ClauseRef) const;
+  void collectGarbage();
+
+  // assignment
+  int litValue(Lit l) const {
+    char a = _assigns[litVar(l)];
+    return (a == SAT_UNDEF)? SAT_UNDEF: (a ^ int(litInv(l)));
+  }
+  int decisionLevel() const { return _trailLim.size(); }
+  void newDecisionLevel() { _trailLim.push_back(_trail.size()); }
+  void enqueue(Lit, ClauseRef);
+  void cancelUntil(int);
+  ClauseRef propagate();
+
+  // search
+  void analyze(ClauseRef, int&, uint32_t&);
+  bool isRedundant(Lit, uint32_t);
+  uint32_t abstractLevel(Var v) const { return 1u << (_level[v] & 31); }
+  void bumpVar(Var);
+  void decayVars() { _varInc *= 1 / 0.95; }
+  Lit pickBranchLit();
+  int search(uint64_t);
+  void reduceDB();
+};
+
+#endif // SAT_H
@@ -0,0 +1,66 @@
+/****************************************************************************
+  FileName     [ satCmd.cpp ]
+  PackageName  [ sat ]
+  Synopsis     [ Define sat package commands ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2010-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include "sat.h"
+#include "satCmd.h"
+#include "util.h"
+#include "myProfile.h"
+
+using namespace std;
+
+bool
+initSatCmd()
+{
+   if (!(regProfiledCmd("SATSolve", 4, new SatSolveCmd)
+      )) {
+      cerr << "Registering \"sat\" commands fails... exiting" << endl;
+      return false;
+   }
+   return true;
+}
+
+//----------------------------------------------------------------------
+//    SATSolve <(string cnfFile)>
+//----------------------------------------------------------------------
+CmdExecStatus
+SatSolveCmd::exec(const string& option)
+{
+   // check option
+   string token;
+   if (!CmdExec::lexSingleOption(option, token, false))
+      return CMD_EXEC_ERROR;
+
+   ifstream cnf(token.c_str());
+   if (!cnf)
+      return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, token);
+   SatSolver solver;
+   if (!solver.readDimacs(cnf)) {
+      cerr << "Error: \"" << token << "\" is not a DIMACS CNF file!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   cout << (solver.solve()? "SATISFIABLE": "UNSATISFIABLE") << endl;
+   solver.printStats();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+SatSolveCmd::usage(ostream& os) const
+{
+   os << "Usage: SATSolve <(string cnfFile)>" << endl;
+}
+
+void
+SatSolveCmd::help() const
+{
+   cout << setw(15) << left << "SATSolve: "
+        << "solve a DIMACS CNF file with the built-in SAT solver\n";
+}
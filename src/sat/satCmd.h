@@ -0,0 +1,16 @@
+/****************************************************************************
+  FileName     [ satCmd.h ]
+  PackageName  [ sat ]
+  Synopsis     [ Define sat package commands ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2010-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef SAT_CMD_H
+#define SAT_CMD_H
+
+#include "cmdParser.h"
+
+CmdClass(SatSolveCmd);
+
+#endif // SAT_CMD_H
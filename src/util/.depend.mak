@@ -1,3 +1,6 @@
 myGetChar.o: myGetChar.cpp
+myProfile.o: myProfile.cpp myProfile.h ../../include/cmdParser.h \
+ ../../include/cmdCharDef.h
 myString.o: myString.cpp
+myTrace.o: myTrace.cpp
 util.o: util.cpp rnGen.h myUsage.h
@@ -1,4 +1,4 @@
-util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h 
+util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h ../../include/myProfile.h ../../include/myTrace.h 
 ../../include/util.h: util.h
 	@rm -f ../../include/util.h
 	@ln -fs ../src/util/util.h ../../include/util.h
@@ -8,3 +8,9 @@ util.d: ../../include/util.h ../../include/rnGen.h ../../include/myUsage.h
 ../../include/myUsage.h: myUsage.h
 	@rm -f ../../include/myUsage.h
 	@ln -fs ../src/util/myUsage.h ../../include/myUsage.h
+../../include/myProfile.h: myProfile.h
+	@rm -f ../../include/myProfile.h
+	@ln -fs ../src/util/myProfile.h ../../include/myProfile.h
+../../include/myTrace.h: myTrace.h
+	@rm -f ../../include/myTrace.h
+	@ln -fs ../src/util/myTrace.h ../../include/myTrace.h
@@ -0,0 +1,190 @@
+/****************************************************************************
+  FileName     [ myProfile.cpp ]
+  PackageName  [ util ]
+  Synopsis     [ Profile the time, memory and allocations of each command ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "myProfile.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------
+//    Global variables in util
+//----------------------------------------------------------------------
+MyProfile myProfile;
+
+//----------------------------------------------------------------------
+//    Replacements of the global operator new and delete
+//----------------------------------------------------------------------
+// Linked in with myProfile; they count only while profiling is on, so
+// the cost otherwise is one relaxed load per allocation
+static atomic<bool>    allocCounting(false);
+static atomic<size_t>  allocCount(0);
+static atomic<size_t>  allocBytes(0);
+
+static void*
+countedAlloc(size_t n)
+{
+   if (allocCounting.load(memory_order_relaxed)) {
+      allocCount.fetch_add(1, memory_order_relaxed);
+      allocBytes.fetch_add(n, memory_order_relaxed);
+   }
+   return malloc(n? n: 1);
+}
+
+void*
+operator new(size_t n)
+{
+   void* p = countedAlloc(n);
+   if (!p) throw bad_alloc();
+   return p;
+}
+
+void*
+operator new[](size_t n)
+{
+   void* p = countedAlloc(n);
+   if (!p) throw bad_alloc();
+   return p;
+}
+
+void* operator new(size_t n, const nothrow_t&) noexcept { return countedAlloc(n); }
+void* operator new[](size_t n, const nothrow_t&) noexcept { return countedAlloc(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+//----------------------------------------------------------------------
+//    Static functions
+//----------------------------------------------------------------------
+// current (not peak) resident set, as the delta of a command is wanted
+static long
+currentRssKb()
+{
+   ifstream statm("/proc/self/statm");
+   long pages = 0, resident = 0;
+   if (statm >> pages >> resident)
+      return resident * (sysconf(_SC_PAGESIZE) / 1024);
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+   return usage.ru_maxrss / 1024;
+#else
+   return usage.ru_maxrss;
+#endif
+}
+
+static double
+cpuSeconds()
+{
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+   return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+          (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static double
+wallSeconds()
+{
+   return chrono::duration<double>(chrono::steady_clock::now()
+                                   .time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------
+//    class MyProfile member functions
+//----------------------------------------------------------------------
+void
+MyProfile::enable(bool on)
+{
+   _enabled = on;
+   _used = _used || on;
+   allocCounting.store(on, memory_order_relaxed);
+}
+
+void
+MyProfile::start(Snapshot& s) const
+{
+   s._rssKb = currentRssKb();
+   s._nAllocs = allocCount.load(memory_order_relaxed);
+   s._allocBytes = allocBytes.load(memory_order_relaxed);
+   s._cpu = cpuSeconds();
+   s._wall = wallSeconds();
+}
+
+void
+MyProfile::stop(const string& cmd, const Snapshot& s)
+{
+   double wall = wallSeconds(), cpu = cpuSeconds();
+   size_t nAllocs = allocCount.load(memory_order_relaxed);
+   size_t bytes = allocBytes.load(memory_order_relaxed);
+   Entry& e = _table[cmd];
+   ++e._calls;
+   e._wall += wall - s._wall;
+   e._cpu += cpu - s._cpu;
+   e._rssKb += currentRssKb() - s._rssKb;
+   e._nAllocs += nAllocs - s._nAllocs;
+   e._allocBytes += bytes - s._allocBytes;
+}
+
+struct ProfileWallGreater
+{
+   template<class T>
+   bool operator() (const T* a, const T* b) const {
+      return a->second._wall > b->second._wall;
+   }
+};
+
+void
+MyProfile::report(ostream& os) const
+{
+   typedef map<string, Entry>::value_type Row;
+   vector<const Row*> rows;
+   for (map<string, Entry>::const_iterator it = _table.begin();
+        it != _table.end(); ++it)
+      rows.push_back(&*it);
+   stable_sort(rows.begin(), rows.end(), ProfileWallGreater());
+
+   ostringstream oss;
+   oss << fixed << setprecision(3);
+   oss << left << setw(14) << "Command" << right << setw(7) << "Calls"
+       << setw(11) << "Wall(s)" << setw(11) << "CPU(s)" << setw(11)
+       << "RSS(MB)" << setw(12) << "Allocs" << setw(12) << "Alloc(MB)"
+       << '\n';
+   Entry total;
+   for (size_t i = 0, n = rows.size(); i < n; ++i) {
+      const Entry& e = rows[i]->second;
+      oss << left << setw(14) << rows[i]->first << right << setw(7)
+          << e._calls << setw(11) << e._wall << setw(11) << e._cpu
+          << setw(11) << e._rssKb / 1024.0 << setw(12) << e._nAllocs
+          << setw(12) << e._allocBytes / 1048576.0 << '\n';
+      total._calls += e._calls;
+      total._wall += e._wall;
+      total._cpu += e._cpu;
+      total._rssKb += e._rssKb;
+      total._nAllocs += e._nAllocs;
+      total._allocBytes += e._allocBytes;
+   }
+   oss << left << setw(14) << "Total" << right << setw(7) << total._calls
+       << setw(11) << total._wall << setw(11) << total._cpu << setw(11)
+       << total._rssKb / 1024.0 << setw(12) << total._nAllocs << setw(12)
+       << total._allocBytes / 1048576.0 << '\n';
+   os << oss.str();
+   os.flush();
+}
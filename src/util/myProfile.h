@@ -0,0 +1,103 @@
+/****************************************************************************
+  FileName     [ myProfile.h ]
+  PackageName  [ util ]
+  Synopsis     [ Profile the time, memory and allocations of each command ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef MY_PROFILE_H
+#define MY_PROFILE_H
+
+#include <iostream>
+#include <string>
+#include <map>
+#include "cmdParser.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------
+//    class MyProfile
+//----------------------------------------------------------------------
+// Totals per command name: wall-clock and CPU time, change of the
+// resident set, and the calls to the global operator new (counted only
+// while profiling is on; see myProfile.cpp).
+class MyProfile
+{
+public:
+   struct Snapshot
+   {
+      double  _wall;
+      double  _cpu;
+      long    _rssKb;
+      size_t  _nAllocs;
+      size_t  _allocBytes;
+   };
+
+   MyProfile(): _enabled(false), _used(false) {}
+
+   void enable(bool on);
+   bool isEnabled() const { return _enabled; }
+   // true once profiling has been turned on
+   bool isUsed() const { return _used; }
+
+   void start(Snapshot&) const;
+   void stop(const string& cmd, const Snapshot&);
+   void reset() { _table.clear(); }
+   // sorted by wall-clock time
+   void report(ostream&) const;
+
+private:
+   struct Entry
+   {
+      Entry(): _calls(0), _wall(0), _cpu(0), _rssKb(0), _nAllocs(0),
+               _allocBytes(0) {}
+      unsigned  _calls;
+      double    _wall;
+      double    _cpu;
+      long      _rssKb;
+      size_t    _nAllocs;
+      size_t    _allocBytes;
+   };
+
+   bool                  _enabled;
+   bool                  _used;
+   map<string, Entry>    _table;
+};
+
+extern MyProfile myProfile;
+
+//----------------------------------------------------------------------
+//    class ProfiledCmd
+//----------------------------------------------------------------------
+// Wraps a command at registration so that its executions are recorded
+// under "name" while profiling is on; libcmd itself is left untouched.
+class ProfiledCmd: public CmdExec
+{
+public:
+   ProfiledCmd(const string& name, CmdExec* cmd): _name(name), _cmd(cmd) {}
+   ~ProfiledCmd() { delete _cmd; }
+
+   CmdExecStatus exec(const string& option) {
+      if (!myProfile.isEnabled()) return _cmd->exec(option);
+      MyProfile::Snapshot s;
+      myProfile.start(s);
+      CmdExecStatus status = _cmd->exec(option);
+      myProfile.stop(_name, s);
+      return status;
+   }
+   void usage(ostream& os) const { _cmd->usage(os); }
+   void help() const { _cmd->help(); }
+
+private:
+   string     _name;
+   CmdExec*   _cmd;
+};
+
+inline bool
+regProfiledCmd(const string& name, unsigned nCmp, CmdExec* cmd)
+{
+   return cmdMgr->regCmd(name, nCmp, new ProfiledCmd(name, cmd));
+}
+
+#endif // MY_PROFILE_H
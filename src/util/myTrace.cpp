@@ -0,0 +1,113 @@
+/****************************************************************************
+  FileName     [ myTrace.cpp ]
+  PackageName  [ util ]
+  Synopsis     [ Scoped spans dumped in the Chrome trace-event format ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifdef MY_TRACE
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+#include "myTrace.h"
+
+using namespace std;
+
+//----------------------------------------------------------------------
+//    Global variables in util
+//----------------------------------------------------------------------
+MyTrace myTrace;
+
+//----------------------------------------------------------------------
+//    class MyTrace member functions
+//----------------------------------------------------------------------
+MyTrace::~MyTrace()
+{
+   for (size_t i = 0, n = _buffers.size(); i < n; ++i)
+      delete _buffers[i];
+}
+
+void
+MyTrace::record(const char* name, uint64_t begin, uint64_t end)
+{
+   Span s = { name, begin, end - begin };
+   getBuffer()->_spans.push_back(s);
+}
+
+size_t
+MyTrace::getNumSpans() const
+{
+   lock_guard<mutex> lock(_mutex);
+   size_t n = 0;
+   for (size_t i = 0, s = _buffers.size(); i < s; ++i)
+      n += _buffers[i]->_spans.size();
+   return n;
+}
+
+void
+MyTrace::clear()
+{
+   lock_guard<mutex> lock(_mutex);
+   for (size_t i = 0, n = _buffers.size(); i < n; ++i)
+      _buffers[i]->_spans.clear();
+}
+
+// Times in microseconds, as the format wants; a thread is a row (tid)
+void
+MyTrace::dump(ostream& os) const
+{
+   lock_guard<mutex> lock(_mutex);
+   ostringstream oss;
+   oss << fixed << setprecision(3);
+   oss << "{\"traceEvents\": [";
+   const char* sep = "\n";
+   int pid = getpid();
+   for (size_t i = 0, n = _buffers.size(); i < n; ++i) {
+      const Buffer& b = *_buffers[i];
+      for (size_t j = 0, m = b._spans.size(); j < m; ++j) {
+         const Span& s = b._spans[j];
+         oss << sep << "{\"name\": \"" << s._name << "\", \"ph\": \"X\", "
+             << "\"ts\": " << s._begin / 1000.0 << ", \"dur\": "
+             << s._dur / 1000.0 << ", \"pid\": " << pid << ", \"tid\": "
+             << b._tid << "}";
+         sep = ",\n";
+      }
+   }
+   oss << "\n], \"displayTimeUnit\": \"ms\"}\n";
+   os << oss.str();
+   os.flush();
+}
+
+MyTrace::Buffer*
+MyTrace::getBuffer()
+{
+   static thread_local BufferRef ref;
+   if (ref._buffer) return ref._buffer;
+   lock_guard<mutex> lock(_mutex);
+   for (size_t i = 0, n = _buffers.size(); i < n && !ref._buffer; ++i)
+      if (!_buffers[i]->_inUse) ref._buffer = _buffers[i];
+   if (!ref._buffer) {
+      ref._buffer = new Buffer;
+      ref._buffer->_tid = _buffers.size();
+      _buffers.push_back(ref._buffer);
+   }
+   ref._buffer->_inUse = true;
+   return ref._buffer;
+}
+
+void
+MyTrace::releaseBuffer(Buffer* buffer)
+{
+   lock_guard<mutex> lock(_mutex);
+   buffer->_inUse = false;
+}
+
+MyTrace::BufferRef::~BufferRef()
+{
+   if (_buffer) myTrace.releaseBuffer(_buffer);
+}
+
+#endif // MY_TRACE
@@ -0,0 +1,118 @@
+/****************************************************************************
+  FileName     [ myTrace.h ]
+  PackageName  [ util ]
+  Synopsis     [ Scoped spans dumped in the Chrome trace-event format ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2007-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef MY_TRACE_H
+#define MY_TRACE_H
+
+// TRACE_SPAN("name") times the enclosing scope while tracing is on. The
+// spans are only built in with -DMY_TRACE ("make TRACE=1" after a "make
+// clean"); otherwise TRACE_SPAN() compiles to nothing and myTrace does
+// not exist.
+#ifdef MY_TRACE
+
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <stdint.h>
+
+using namespace std;
+
+//----------------------------------------------------------------------
+//    class MyTrace
+//----------------------------------------------------------------------
+// Each thread appends its spans to a buffer of its own; the buffers are
+// only handed out under the lock, and are kept until exit, so dump() and
+// clear() must not race with running spans. A thread gives its buffer back
+// when it exits, and the next thread to start a span takes it over (with
+// its row in the trace), so that threads started over and over (e.g. by
+// every round of CIRFraig) do not each add a row.
+class MyTrace
+{
+public:
+   MyTrace(): _enabled(false), _start(chrono::steady_clock::now()) {}
+   ~MyTrace();
+
+   void enable(bool on) { _enabled.store(on, memory_order_relaxed); }
+   bool isEnabled() const { return _enabled.load(memory_order_relaxed); }
+
+   // nanoseconds since the start of the program
+   uint64_t now() const {
+      return chrono::duration_cast<chrono::nanoseconds>
+         (chrono::steady_clock::now() - _start).count();
+   }
+   // now(), after claiming a buffer for this thread
+   uint64_t begin() { getBuffer(); return now(); }
+   void record(const char* name, uint64_t begin, uint64_t end);
+
+   size_t getNumSpans() const;
+   void clear();
+   // {"traceEvents": [...]} with one complete ("X") event per span
+   void dump(ostream&) const;
+
+private:
+   struct Span
+   {
+      const char*  _name;
+      uint64_t     _begin;
+      uint64_t     _dur;
+   };
+   struct Buffer
+   {
+      unsigned       _tid;
+      bool           _inUse;
+      vector<Span>   _spans;
+   };
+   // a thread's hold on its buffer
+   struct BufferRef
+   {
+      BufferRef(): _buffer(0) {}
+      ~BufferRef();
+      Buffer*  _buffer;
+   };
+
+   atomic<bool>                       _enabled;
+   chrono::steady_clock::time_point   _start;
+   mutable mutex                      _mutex;
+   vector<Buffer*>                    _buffers;
+
+   Buffer* getBuffer();
+   void releaseBuffer(Buffer*);
+};
+
+extern MyTrace myTrace;
+
+//----------------------------------------------------------------------
+//    class MyTraceSpan
+//----------------------------------------------------------------------
+class MyTraceSpan
+{
+public:
+   // "name" must outlive the trace (a string literal)
+   MyTraceSpan(const char* name)
+      : _name(myTrace.isEnabled()? name: 0),
+        _begin(_name? myTrace.begin(): 0) {}
+   ~MyTraceSpan() { if (_name) myTrace.record(_name, _begin, myTrace.now()); }
+
+private:
+   const char*  _name;
+   uint64_t     _begin;
+};
+
+#define TRACE_CAT2(a, b)  a##b
+#define TRACE_CAT(a, b)   TRACE_CAT2(a, b)
+#define TRACE_SPAN(name)  MyTraceSpan TRACE_CAT(_traceSpan, __LINE__)(name)
+
+#else  // MY_TRACE
+
+#define TRACE_SPAN(name)  ((void)0)
+
+#endif // MY_TRACE
+
+#endif // MY_TRACE_H
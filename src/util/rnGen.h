@@ -12,6 +12,7 @@
 #include <sys/types.h>
 #include <stdlib.h>  
 #include <limits.h>
+#include <stdint.h>
 
 #define my_srandom  srandom
 #define my_random   random
@@ -26,5 +27,21 @@ class RandomNumGen
       }
 };
 
+// 64 random bits per call (xorshift64*). Each user owns its own seeded
+// generator, so that it does not shift the sequence of my_random(), which
+// CIRSIMulate draws from.
+class RandomWordGen
+{
+   public:
+      RandomWordGen(uint64_t seed = 0x9E3779B97F4A7C15ULL): _x(seed) {}
+      uint64_t operator() () {
+         _x ^= _x >> 12; _x ^= _x << 25; _x ^= _x >> 27;
+         return _x * 0x2545F4914F6CDD1DULL;
+      }
+
+   private:
+      uint64_t _x;
+};
+
 #endif // RN_GEN_H
 